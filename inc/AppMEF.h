@@ -28,8 +28,11 @@ SPDX-License-Identifier: MIT
 
 /* === Headers files inclusions ==================================================================================== */
 
-#include "bsp.h"
+#include "FreeRTOS.h"
+#include "event_groups.h"
 #include "clock.h"
+#include "key_controller.h"
+#include "mef.h"
 
 /* === Header for C++ compatibility ================================================================================ */
 
@@ -39,19 +42,22 @@ extern "C" {
 
 /* === Public macros definitions =================================================================================== */
 
+#define MEF_EVENT_KEY          (1 << 0) //!< Bit del grupo de eventos que indica que hay eventos de teclas en la cola
+#define MEF_EVENT_CLOCK_MINUTE (1 << 8) //!< Bit del grupo de eventos que indica que el reloj pasó a un nuevo minuto
+
 /* === Public data type declarations =============================================================================== */
 
 //! Estructura con los datos que deben pasarse como argumento de la tarea MEFTask()
 typedef struct mef_task_args_s {
-    const struct board_s* board;    //!< Puntero a la estructura con los datos de la placa
-    clock_t clock;                  //!< Puntero a la estructura con los datos del reloj
-    uint8_t set_time_mask;          //!< Máscara que representa al evento producido al mantener pulsado el botón "set_time"
-    uint8_t increment_mask;         //!< Máscara que representa al evento producido al pulsar el botón "increment"
-    uint8_t decrement_mask;         //!< Máscara que representa al evento producido al pulsar el botón "decrement"
-    uint8_t accept_mask;            //!< Máscara que representa al evento producido al pulsar el botón "accept"
-    uint8_t cancel_mask;            //!< Máscara que representa al evento producido al pulsar el botón "cancel"
-    uint8_t set_alarm_mask;         //!< Máscara que representa al evento producido al mantener pulsado el botón "set_alarm"
-    EventGroupHandle_t event_group; //!< Grupo de 32 bits que representan los posibles eventos producidos por los botones
+    mef_t mef;                      //!< MEF del reloj despertador, ya creada, que la tarea pone en marcha y hace avanzar
+    key_controller_t keys;          //!< Gestor de teclas de cuya cola se consumen los eventos de las teclas
+    uint8_t set_time_key;           //!< Número de la tecla "set_time" (se usa su pulsación larga)
+    uint8_t increment_key;          //!< Número de la tecla "increment"
+    uint8_t decrement_key;          //!< Número de la tecla "decrement"
+    uint8_t accept_key;             //!< Número de la tecla "accept"
+    uint8_t cancel_key;             //!< Número de la tecla "cancel"
+    uint8_t set_alarm_key;          //!< Número de la tecla "set_alarm" (se usa su pulsación larga)
+    EventGroupHandle_t event_group; //!< Grupo de eventos con el que se despierta a la MEF (MEF_EVENT_*)
 }* mef_task_args_t;
 
 /* === Public variable declarations ================================================================================ */
@@ -62,9 +68,33 @@ typedef struct mef_task_args_s {
  * @brief Tarea que realiza el cambio de estados de la MEF al usar FreeRTOS
  *
  * @param arguments Argumentos que deben pasarse a la tarea.
+ *
+ * NOTA: La tarea solo adapta FreeRTOS al núcleo de la MEF (ver mef.h): espera en el grupo de eventos como máximo hasta
+ * que se cumpla el tiempo sin pulsaciones del estado actual, traduce los gestos de las teclas a entradas de la MEF y
+ * le entrega cada una con la cuenta de ticks actual
  */
 void MEFTask(void* arguments);
 
+/**
+ * @brief Función de notificación del reloj que traslada sus eventos al grupo de eventos de la MEF
+ *
+ * @param event_group Grupo de eventos de la MEF (el mismo que se pasa en los argumentos de MEFTask())
+ * @param events Máscara con los eventos CLOCK_EVENT_* ocurridos
+ *
+ * NOTA: Debe registrarse con ClockSetNotificationSink(), suscribiendo al menos CLOCK_EVENT_MINUTE, para que la hora
+ * mostrada se actualice. Al cambiar el minuto se fija el bit MEF_EVENT_CLOCK_MINUTE
+ */
+void MEFClockNotify(void* event_group, uint32_t events);
+
+/**
+ * @brief Función de notificación del gestor de teclas que despierta a la MEF cuando hay eventos en la cola
+ *
+ * @param event_group Grupo de eventos de la MEF (el mismo que se pasa en los argumentos de MEFTask())
+ *
+ * NOTA: Debe registrarse con KeyControllerSetNotificationSink(). Fija el bit MEF_EVENT_KEY
+ */
+void MEFKeyNotify(void* event_group);
+
 /* === End of conditional blocks =================================================================================== */
 
 #ifdef __cplusplus
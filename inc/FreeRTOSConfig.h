@@ -42,7 +42,18 @@
 
 /* clang-format off */
 
+/* With USE_STATIC_MEMORY the firmware does not use dynamic memory at all: every kernel object is created
+ * with its xxxCreateStatic() variant and the FreeRTOS heap is not needed. The heap_x.c that the muju freertos
+ * module links is still compiled, so its ucHeap array is given no size ("make heap-check" verifies the result). */
+#ifdef USE_STATIC_MEMORY
+#define configSUPPORT_STATIC_ALLOCATION  1
+#define configSUPPORT_DYNAMIC_ALLOCATION 0
+#define configTOTAL_HEAP_SIZE            ((size_t)0)
+#else
 #define configSUPPORT_STATIC_ALLOCATION  0
+#define configSUPPORT_DYNAMIC_ALLOCATION 1
+#define configTOTAL_HEAP_SIZE            ((size_t)(16 * 1024)) /* 16 Kbytes. */
+#endif
 
 #define configUSE_PREEMPTION             1
 #define configUSE_IDLE_HOOK              0
@@ -53,7 +64,6 @@
 #define configMAX_PRIORITIES             (15)
 #define configMINIMAL_STACK_SIZE         ((uint16_t)128)
 #define configAPPLICATION_ALLOCATED_HEAP 0
-#define configTOTAL_HEAP_SIZE            ((size_t)(16 * 1024)) /* 16 Kbytes. */
 #define configMAX_TASK_NAME_LEN          (16)
 #define configUSE_TRACE_FACILITY         1
 #define configUSE_16_BIT_TICKS           0
@@ -65,7 +75,22 @@
 #define configUSE_MALLOC_FAILED_HOOK     0
 #define configUSE_APPLICATION_TASK_TAG   0
 #define configUSE_COUNTING_SEMAPHORES    1
-#define configGENERATE_RUN_TIME_STATS    0
+
+/* With USE_RUNTIME_STATS the kernel accounts the CPU time used by every task, so the share of each one can be read
+ * with vTaskGetRunTimeStats() (for instance, calling it from the debugger). The counter needs no extra timer: it counts
+ * hundredths of a tick from the tick count plus the elapsed part of the current SysTick period, and wraps after about
+ * 12 hours. ulGetRunTimeCounterValue() is defined in main.c, because the two readings must be taken from the same
+ * SysTick period, including one whose interrupt is still pending. */
+#ifdef USE_RUNTIME_STATS
+#define configGENERATE_RUN_TIME_STATS        1
+#define configUSE_STATS_FORMATTING_FUNCTIONS 1
+#define INCLUDE_xTaskGetIdleTaskHandle       1
+extern uint32_t ulGetRunTimeCounterValue(void);
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+#define portGET_RUN_TIME_COUNTER_VALUE() ulGetRunTimeCounterValue()
+#else
+#define configGENERATE_RUN_TIME_STATS        0
+#endif
 
 /* Co-routine definitions. */
 #define configUSE_CO_ROUTINES           0
@@ -39,6 +39,22 @@ extern "C" {
 
 /* === Public macros definitions =================================================================================== */
 
+#define BOARD_KEYS              6 //!< Cantidad de teclas del poncho que utiliza la placa
+
+#define BOARD_KEY_F1            0 //!< Número de la tecla "F1" en las interrupciones y en BoardReadKeys()
+#define BOARD_KEY_F2            1 //!< Número de la tecla "F2" en las interrupciones y en BoardReadKeys()
+#define BOARD_KEY_F3            2 //!< Número de la tecla "F3" en las interrupciones y en BoardReadKeys()
+#define BOARD_KEY_F4            3 //!< Número de la tecla "F4" en las interrupciones y en BoardReadKeys()
+#define BOARD_KEY_ACCEPT        4 //!< Número de la tecla "Aceptar" en las interrupciones y en BoardReadKeys()
+#define BOARD_KEY_CANCEL        5 //!< Número de la tecla "Cancelar" en las interrupciones y en BoardReadKeys()
+
+//! Prioridad de las interrupciones de las teclas. Debe ser igual o menos urgente que configMAX_SYSCALL_INTERRUPT_PRIORITY
+#define BOARD_KEYS_IRQ_PRIORITY 6
+
+//! Prioridad de la interrupción del temporizador de la pantalla. Es más urgente que las teclas para que el barrido no
+//! tenga demoras visibles, pero no supera configMAX_SYSCALL_INTERRUPT_PRIORITY para poder usar funciones FromISR
+#define BOARD_SCREEN_IRQ_PRIORITY 5
+
 /* === Public data type declarations =============================================================================== */
 
 //! Estructura de datos que representa a la placa de desarrollo
@@ -53,16 +69,115 @@ typedef struct board_s {
     screen_t screen;            //!< Pantalla formada por los displays 7 segmentos del pocnho
 } const* const board_t;
 
+//! Memoria en la que se crea la placa con BoardCreateStatic(), incluyendo la de sus entradas, salidas y pantalla
+typedef struct board_storage_s {
+    struct board_s board;                     //!< Estructura con los datos de la placa
+    digital_input_storage_t keys[BOARD_KEYS]; //!< Memoria de las teclas del poncho
+    digital_output_storage_t led_alarm;       //!< Memoria del led que representa la alarma
+    screen_storage_t screen;                  //!< Memoria de la pantalla
+} board_storage_t;
+
+/**
+ * @brief Tipo de dato que representa la función que se llama desde la interrupción de una tecla del poncho
+ *
+ * @param context Contexto indicado al habilitar las interrupciones
+ *
+ * NOTA: La interrupción solo avisa que alguna tecla cambió; el estado de todas se obtiene con BoardReadKeys()
+ */
+typedef void (*board_key_handler_t)(void* context);
+
+/**
+ * @brief Tipo de dato que representa la función que se llama en cada interrupción del temporizador de la pantalla
+ *
+ * @param context Contexto indicado al iniciar el temporizador
+ */
+typedef void (*board_timer_handler_t)(void* context);
+
+#ifdef USE_CYCLE_PROBE
+//! Secciones de código cuya duración en ciclos de CPU se mide al compilar con "make USE_CYCLE_PROBE=y"
+typedef enum board_probe_e {
+    BOARD_PROBE_SCREEN_REFRESH,  //!< Refresco de la pantalla desde la interrupción del temporizador (ScreenRefresh())
+    BOARD_PROBE_SEGMENTS_UPDATE, //!< Cambio de los segmentos del display, en el driver de la pantalla (SegmentsUpdate())
+    BOARD_PROBE_DIGIT_TURN_ON,   //!< Encendido de un display, en el driver de la pantalla (DigitTurnOn())
+    BOARD_PROBE_COUNT,           //!< Cantidad de secciones medidas (no es una sección)
+} board_probe_t;
+
+//! Ciclos de CPU medidos en una sección de código
+typedef struct board_cycles_s {
+    uint32_t last;  //!< Ciclos de la última ejecución
+    uint32_t min;   //!< Menor cantidad de ciclos medida
+    uint32_t max;   //!< Mayor cantidad de ciclos medida
+    uint32_t count; //!< Cantidad de ejecuciones medidas
+} board_cycles_t;
+#endif
+
 /* === Public variable declarations ================================================================================ */
 
 /* === Public function declarations ================================================================================ */
 
+#ifndef USE_STATIC_MEMORY
 /**
  * @brief Función que permite inicializar la placa, a medida del proyecto planteado
  *
  * @return board_t Puntero a la estructura con los datos de la placa
  */
 board_t BoardCreate();
+#endif
+
+/**
+ * @brief Función que permite inicializar la placa en una memoria reservada por la aplicación, sin utilizar memoria dinámica
+ *
+ * @param storage Memoria en la que se crearán la placa, sus entradas, salidas y pantalla
+ * @return board_t Puntero a la estructura con los datos de la placa, o NULL si no se indicó la memoria
+ */
+board_t BoardCreateStatic(board_storage_t* storage);
+
+/**
+ * @brief Función que habilita las interrupciones por flanco (ascendente y descendente) de las teclas del poncho
+ *
+ * @param board Puntero a la estructura con los datos de la placa
+ * @param handler Función que se llama desde la interrupción de cualquiera de las teclas
+ * @param context Contexto que se le pasa a la función en cada llamada
+ *
+ * NOTA: Cada tecla usa el canal de interrupción de pines (PININT) de igual número que la tecla
+ */
+void BoardEnableKeyInterrupts(board_t board, board_key_handler_t handler, void* context);
+
+/**
+ * @brief Función que inicia el temporizador que refresca la pantalla desde su interrupción, sin intervención de tareas
+ *
+ * @param board Puntero a la estructura con los datos de la placa
+ * @param frequency Cantidad de interrupciones por segundo (una por dígito refrescado)
+ * @param handler Función que se llama desde la interrupción del temporizador
+ * @param context Contexto que se le pasa a la función en cada llamada
+ *
+ * NOTA: Utiliza el TIMER0, que se reinicia por hardware en cada coincidencia, por lo que el período no depende de la
+ * demora en atender la interrupción ni del planificador de FreeRTOS
+ */
+void BoardStartScreenTimer(board_t board, uint32_t frequency, board_timer_handler_t handler, void* context);
+
+/**
+ * @brief Función que lee el estado de todas las teclas del poncho con una única lectura del puerto GPIO
+ *
+ * @return uint32_t Estado de las teclas, con el bit BOARD_KEY_* de cada tecla en 1 si está pulsada
+ */
+uint32_t BoardReadKeys(void);
+
+#ifdef USE_CYCLE_PROBE
+/**
+ * @brief Función que permite leer los ciclos de CPU medidos en una sección de código
+ *
+ * @param probe Sección de código (BOARD_PROBE_*)
+ * @param cycles Puntero a la estructura donde se guardarán los ciclos medidos
+ * @return true Si se pudieron leer los ciclos
+ * @return false Si la sección no existe o no se indicó dónde guardar los ciclos
+ *
+ * NOTA: Solo existe al compilar con USE_CYCLE_PROBE. Los ciclos se cuentan con DWT->CYCCNT, a la frecuencia del núcleo,
+ * desde que se crea la placa, y ya tienen descontado el costo de la propia medición. Las funciones del driver se
+ * ejecutan dentro de ScreenRefresh(), por lo que sus mediciones también suman su costo al de ScreenRefresh()
+ */
+bool BoardGetCycles(board_probe_t probe, board_cycles_t* cycles);
+#endif
 
 /* === End of conditional blocks =================================================================================== */
 
@@ -30,6 +30,9 @@ SPDX-License-Identifier: MIT
 
 #include <stdbool.h>
 #include <stdint.h>
+#ifdef USE_STATIC_MEMORY
+#include "FreeRTOS.h"
+#endif
 
 /* === Header for C++ compatibility ================================================================================ */
 
@@ -39,6 +42,35 @@ extern "C" {
 
 /* === Public macros definitions =================================================================================== */
 
+#define CLOCK_NO_ALARM_PENDING     0xFFFFFFFFU //!< Valor devuelto por ClockGetTicksToNextAlarm() cuando no hay ninguna alarma pendiente
+
+#define CLOCK_EVENT_ALARM_FIRED    (1U << 0) //!< Evento: una alarma sonó al alcanzar su hora
+#define CLOCK_EVENT_SNOOZE_EXPIRED (1U << 1) //!< Evento: una alarma volvió a sonar al vencer su posposición
+#define CLOCK_EVENT_SECOND         (1U << 2) //!< Evento: la hora avanzó al menos un segundo
+#define CLOCK_EVENT_MINUTE         (1U << 3) //!< Evento: la hora pasó a un nuevo minuto
+
+//! Eventos que indican que una alarma comenzó a sonar
+#define CLOCK_EVENT_ALARM          (CLOCK_EVENT_ALARM_FIRED | CLOCK_EVENT_SNOOZE_EXPIRED)
+
+#ifndef CLOCK_MAX_ALARMS
+#define CLOCK_MAX_ALARMS 8 //!< Cantidad de alarmas independientes que puede tener el reloj (entre 1 y 255)
+#endif
+
+#if (CLOCK_MAX_ALARMS < 1) || (CLOCK_MAX_ALARMS > 255)
+#error "CLOCK_MAX_ALARMS debe estar entre 1 y 255"
+#endif
+
+#ifdef USE_STATIC_MEMORY
+#define CLOCK_TIMER_STORAGE_SIZE sizeof(StaticTimer_t)     //!< Memoria reservada en el reloj para su temporizador del modo sin tick
+#define CLOCK_LOCK_STORAGE_SIZE  sizeof(StaticSemaphore_t) //!< Memoria reservada en el reloj para su mutex
+#else
+#define CLOCK_TIMER_STORAGE_SIZE 0 //!< Con memoria dinámica, el temporizador del modo sin tick se crea en el heap de FreeRTOS
+#define CLOCK_LOCK_STORAGE_SIZE  0 //!< Con memoria dinámica, el mutex del reloj se crea en el heap de FreeRTOS
+#endif
+
+//! Cantidad de bytes que se reservan para crear un reloj con ClockCreateStatic()
+#define CLOCK_STORAGE_SIZE (16 + 13 * sizeof(void*) + CLOCK_MAX_ALARMS * (17 + sizeof(void*)) + CLOCK_TIMER_STORAGE_SIZE + CLOCK_LOCK_STORAGE_SIZE)
+
 /* === Public data type declarations =============================================================================== */
 
 //! Estructura de datos que representa la hora de dos posibles formas: Como un struct y como un arreglo
@@ -54,12 +86,34 @@ typedef union {
 //! Estructura de datos que representa el Reloj
 typedef struct clock_s* clock_t;
 
+/**
+ * @brief Memoria en la que se puede crear un reloj con ClockCreateStatic(), sin utilizar memoria dinámica
+ *
+ * NOTA: Su contenido es privado del módulo. Se declara solo para que la aplicación pueda reservarla en forma
+ * estática, con un tamaño conocido en tiempo de compilación
+ */
+typedef union clock_storage_u {
+    uint8_t reserved[CLOCK_STORAGE_SIZE]; //!< Memoria reservada para los datos internos del reloj
+    void* alignment;                      //!< Fuerza la alineación que requieren los datos internos del reloj
+} clock_storage_t;
+
 //! Tipo de dato que representa una función que permite encender la alarma
 typedef void (*clock_alarm_turn_on)(void);
 
 //! Tipo de dato que representa una función que permite apagar la alarma
 typedef void (*clock_alarm_turn_of)(void);
 
+//! Tipo de dato que representa una función que devuelve la cuenta actual de una base de tiempo libre, en ticks del reloj
+typedef uint32_t (*clock_tick_source_t)(void);
+
+/**
+ * @brief Tipo de dato que representa una función que recibe las notificaciones de eventos del reloj
+ *
+ * @param context Contexto indicado al registrar la función (por ejemplo, un grupo de eventos o una tarea)
+ * @param events Máscara con los eventos CLOCK_EVENT_* ocurridos desde la notificación anterior
+ */
+typedef void (*clock_notify_t)(void* context, uint32_t events);
+
 //! Estructura de datos que representa el driver del reloj con las funciones de callback para gestionar la alarma
 typedef struct clock_alarm_driver_s {
     clock_alarm_turn_on ClockAlarmTurnOn;  //!< Función que permite encender el sonido de la alarma
@@ -70,6 +124,7 @@ typedef struct clock_alarm_driver_s {
 
 /* === Public function declarations ================================================================================ */
 
+#ifndef USE_STATIC_MEMORY
 /**
  * @brief Función que permite crear al objeto reloj
  *
@@ -79,6 +134,18 @@ typedef struct clock_alarm_driver_s {
  * @return clock_t
  */
 clock_t ClockCreate(uint16_t ticks_per_second, uint16_t snooze_seconds, clock_alarm_driver_t driver);
+#endif
+
+/**
+ * @brief Función que permite crear al objeto reloj en una memoria reservada por la aplicación
+ *
+ * @param storage Memoria en la que se creará el reloj. Debe existir mientras se utilice el reloj
+ * @param ticks_per_second Cantidad de ticks que hay en un segundo
+ * @param snooze_seconds Cantidad de segundos que se pospone la alarma (si es que se pospone)
+ * @param driver Driver con las funciones para encender y apagar la alarma
+ * @return clock_t Reloj creado, o NULL si no se indicó la memoria
+ */
+clock_t ClockCreateStatic(clock_storage_t* storage, uint16_t ticks_per_second, uint16_t snooze_seconds, clock_alarm_driver_t driver);
 
 /**
  * @brief Función que permite obtener la hora actual del reloj
@@ -97,6 +164,9 @@ bool ClockGetTime(clock_t clock, clock_time_t* result);
  * @param time_set Puntero a la estructura con la hora, minutos y segundos que se desean setear
  * @return true Si la hora seteada es válida
  * @return false Si la hora seteada es inválida
+ *
+ * NOTA: Si la hora ya era válida y el ajuste la adelanta (como máximo CLOCK_ALARM_CATCH_UP_SECONDS) por encima del
+ * instante en el que debía sonar la alarma, la alarma suena en ese momento en lugar de perderse hasta el día siguiente
  */
 bool ClockSetTime(clock_t clock, const clock_time_t* time_set);
 
@@ -107,6 +177,84 @@ bool ClockSetTime(clock_t clock, const clock_time_t* time_set);
  */
 void ClockTick(clock_t clock);
 
+/**
+ * @brief Función que permite registrar la función a la que el reloj notifica sus eventos
+ *
+ * @param clock Puntero a la estructura con los datos del Reloj
+ * @param notify Función que recibe las notificaciones (NULL para dejar de notificar)
+ * @param context Contexto que se le pasa a la función en cada notificación
+ * @param events Máscara con los eventos CLOCK_EVENT_* que se desean recibir
+ *
+ * NOTA: La función se llama desde la tarea que avanza el reloj (la que llama a ClockTick(), ClockSync() o
+ * ClockAdvance(), o el temporizador del modo sin tick), una vez actualizada la hora, por lo que no debe bloquearse.
+ * Lo habitual es que solo fije un bit de un grupo de eventos, envíe una notificación a una tarea o escriba en una
+ * cola. En modo sin tick, suscribirse a CLOCK_EVENT_SECOND o CLOCK_EVENT_MINUTE hace que el reloj se despierte en
+ * cada cambio de segundo o de minuto
+ */
+void ClockSetNotificationSink(clock_t clock, clock_notify_t notify, void* context, uint32_t events);
+
+/**
+ * @brief Función que permite avanzar el reloj una cantidad arbitraria de ticks de una sola vez
+ *
+ * @param clock Puntero a la estructura con los datos del Reloj
+ * @param ticks Cantidad de ticks que se desea avanzar
+ *
+ * NOTA: Equivale a llamar "ticks" veces a ClockTick(), pero en un tiempo que no depende de la cantidad de ticks. Las
+ * alarmas y posposiciones que vencen dentro del intervalo salteado suenan en orden. Si el salto es mayor a dos días,
+ * los días completos intermedios no vuelven a disparar las alarmas, ya que no cambiarían el estado del reloj
+ */
+void ClockAdvance(clock_t clock, uint32_t ticks);
+
+/**
+ * @brief Función que permite que el reloj derive la hora de una base de tiempo libre, en lugar de llamar a ClockTick()
+ *
+ * @param clock Puntero a la estructura con los datos del Reloj
+ * @param source Función que devuelve la cuenta actual de ticks de la base de tiempo (NULL para volver a usar ClockTick)
+ *
+ * NOTA: La base de tiempo debe contar a razón de "ticks_per_second" ticks por segundo y puede desbordar libremente.
+ * La hora se calcula al consultarla, a partir de los ticks transcurridos desde la última sincronización, que no
+ * deben superar 2^31 ticks
+ */
+void ClockSetTickSource(clock_t clock, clock_tick_source_t source);
+
+/**
+ * @brief Función que permite incorporar al reloj los ticks transcurridos en la base de tiempo, procesando la alarma
+ *
+ * @param clock Puntero a la estructura con los datos del Reloj
+ *
+ * NOTA: No tiene efecto si el reloj no tiene una base de tiempo asignada con ClockSetTickSource()
+ */
+void ClockSync(clock_t clock);
+
+/**
+ * @brief Función que permite saber cuántos ticks faltan para que se deba evaluar la próxima alarma (o su posposición)
+ *
+ * @param clock Puntero a la estructura con los datos del Reloj
+ * @return uint32_t Cantidad de ticks hasta la próxima alarma, o CLOCK_NO_ALARM_PENDING si no hay ninguna pendiente
+ */
+uint32_t ClockGetTicksToNextAlarm(clock_t clock);
+
+/**
+ * @brief Función que permite sumar (o restar) una cantidad de minutos a la hora actual, sin modificar las horas
+ *
+ * @param clock Puntero a la estructura con los datos del Reloj
+ * @param minutes Cantidad de minutos a sumar (negativo para restar). Al pasar de 59 se continúa desde 00 y viceversa
+ *
+ * NOTA: El cambio se aplica con una única sincronización y una única reprogramación del temporizador, sin
+ * importar la cantidad de minutos, por lo que debe preferirse a llamar varias veces a ClockIncrementMinutes()
+ */
+void ClockAddMinutes(clock_t clock, int16_t minutes);
+
+/**
+ * @brief Función que permite sumar (o restar) una cantidad de horas a la hora actual, sin modificar los minutos
+ *
+ * @param clock Puntero a la estructura con los datos del Reloj
+ * @param hours Cantidad de horas a sumar (negativo para restar). Al pasar de 23 se continúa desde 00 y viceversa
+ *
+ * NOTA: Al igual que ClockAddMinutes(), el cambio se aplica con una única actualización del reloj
+ */
+void ClockAddHours(clock_t clock, int16_t hours);
+
 /**
  * @brief Función que permite incrementar el valor de los minutos
  *
@@ -142,6 +290,8 @@ void ClockDecrementHours(clock_t clock);
  * @param time_set Puntero a la estructura con la hora, minutos y segundos de la alarma
  * @return true Si se pudo setear la alarma
  * @return false Si no se pudo setear la alarma
+ *
+ * NOTA: Esta función y las demás funciones de alarma sin número de alarma operan sobre la alarma 0 de la tabla
  */
 bool ClockSetAlarm(clock_t clock, const clock_time_t* time_set);
 
@@ -245,6 +395,104 @@ void ClockSnoozeAlarm(clock_t clock);
  */
 void ClockCancelAlarm(clock_t clock);
 
+/**
+ * @brief Función que permite habilitar y setear la hora de una de las alarmas del reloj
+ *
+ * @param clock Puntero a la estructura con los datos del Reloj
+ * @param alarm Número de alarma (entre 0 y CLOCK_MAX_ALARMS - 1)
+ * @param time_set Puntero a la estructura con la hora, minutos y segundos de la alarma
+ * @param driver Driver con las funciones para hacer sonar esta alarma (NULL para conservar el actual, que
+ * inicialmente es el que se indicó al crear el reloj)
+ * @return true Si se pudo setear la alarma
+ * @return false Si no se pudo setear la alarma
+ *
+ * NOTA: Varias alarmas pueden tener la misma hora, en cuyo caso suenan todas en el mismo segundo
+ */
+bool ClockSetAlarmSlot(clock_t clock, uint8_t alarm, const clock_time_t* time_set, clock_alarm_driver_t driver);
+
+/**
+ * @brief Función que permite leer la hora seteada para una de las alarmas del reloj
+ *
+ * @param clock Puntero a la estructura con los datos del Reloj
+ * @param alarm Número de alarma (entre 0 y CLOCK_MAX_ALARMS - 1)
+ * @param alarm_time Puntero a la estructura donde se guardará la hora de la alarma
+ * @return true Si la alarma está activada y se pudo leer su hora
+ * @return false Si no fue posible leer la hora de la alarma
+ */
+bool ClockGetAlarmSlot(clock_t clock, uint8_t alarm, clock_time_t* alarm_time);
+
+/**
+ * @brief Función que permite deshabilitar una de las alarmas del reloj
+ *
+ * @param clock Puntero a la estructura con los datos del Reloj
+ * @param alarm Número de alarma (entre 0 y CLOCK_MAX_ALARMS - 1)
+ */
+void ClockDisableAlarmSlot(clock_t clock, uint8_t alarm);
+
+/**
+ * @brief Función que permite saber si una de las alarmas del reloj está sonando o no
+ *
+ * @param clock Puntero a la estructura con los datos del Reloj
+ * @param alarm Número de alarma (entre 0 y CLOCK_MAX_ALARMS - 1)
+ * @return true Si la alarma está sonando
+ * @return false Si la alarma no está sonando
+ */
+bool ClockGetIfAlarmSlotIsRinging(clock_t clock, uint8_t alarm);
+
+/**
+ * @brief Función que permite posponer una de las alarmas del reloj un determinado tiempo
+ *
+ * @param clock Puntero a la estructura con los datos del Reloj
+ * @param alarm Número de alarma (entre 0 y CLOCK_MAX_ALARMS - 1)
+ */
+void ClockSnoozeAlarmSlot(clock_t clock, uint8_t alarm);
+
+/**
+ * @brief Función que permite apagar el sonido de una de las alarmas del reloj hasta el otro día
+ *
+ * @param clock Puntero a la estructura con los datos del Reloj
+ * @param alarm Número de alarma (entre 0 y CLOCK_MAX_ALARMS - 1)
+ */
+void ClockCancelAlarmSlot(clock_t clock, uint8_t alarm);
+
+/**
+ * @brief Función que permite calcular la hora que resulta de sumar (o restar) una cantidad de segundos a otra hora
+ *
+ * @param time Puntero a la estructura con la hora de partida
+ * @param seconds Cantidad de segundos a sumar (negativo para restar). Se admiten valores mayores a un día
+ * @param result Puntero a la estructura donde se guardará la hora resultante (puede coincidir con "time")
+ * @return true Si la hora de partida es válida y se pudo calcular el resultado
+ * @return false Si la hora de partida es inválida
+ *
+ * NOTA: El cálculo se realiza en tiempo constante, sin importar la cantidad de segundos que se sumen. Al pasar
+ * de 23:59:59 se continúa desde 00:00:00 (y viceversa al restar)
+ */
+bool ClockTimeAddSeconds(const clock_time_t* time, int32_t seconds, clock_time_t* result);
+
+/**
+ * @brief Función que permite calcular la hora que resulta de sumar (o restar) una cantidad de minutos a otra hora,
+ * sin modificar las horas
+ *
+ * @param time Puntero a la estructura con la hora de partida
+ * @param minutes Cantidad de minutos a sumar (negativo para restar). Al pasar de 59 se continúa desde 00 y viceversa
+ * @param result Puntero a la estructura donde se guardará la hora resultante (puede coincidir con "time")
+ * @return true Si la hora de partida es válida y se pudo calcular el resultado
+ * @return false Si la hora de partida es inválida
+ */
+bool ClockTimeAddMinutes(const clock_time_t* time, int16_t minutes, clock_time_t* result);
+
+/**
+ * @brief Función que permite calcular la hora que resulta de sumar (o restar) una cantidad de horas a otra hora,
+ * sin modificar los minutos ni los segundos
+ *
+ * @param time Puntero a la estructura con la hora de partida
+ * @param hours Cantidad de horas a sumar (negativo para restar). Al pasar de 23 se continúa desde 00 y viceversa
+ * @param result Puntero a la estructura donde se guardará la hora resultante (puede coincidir con "time")
+ * @return true Si la hora de partida es válida y se pudo calcular el resultado
+ * @return false Si la hora de partida es inválida
+ */
+bool ClockTimeAddHours(const clock_time_t* time, int16_t hours, clock_time_t* result);
+
 /**
  * @brief Tarea para implementar el tick del reloj utilizando FreeRTOS
  *
@@ -252,6 +500,20 @@ void ClockCancelAlarm(clock_t clock);
  */
 void ClockTickTask(void* clock);
 
+/**
+ * @brief Función que pone al reloj en modo sin tick utilizando FreeRTOS, en reemplazo de ClockTickTask()
+ *
+ * @param clock Puntero a la estructura con los datos del Reloj
+ * @return true Si se pudo crear el temporizador del reloj
+ * @return false Si no se pudo crear el temporizador, o si los ticks por segundo del reloj no coinciden con los de FreeRTOS
+ *
+ * NOTA: La hora se calcula a partir de xTaskGetTickCount() cada vez que se consulta, y un único temporizador de un
+ * disparo despierta al reloj cuando se debe evaluar la próxima alarma (o, como máximo, una vez por hora). Las tareas
+ * que modifican el reloj y el temporizador se serializan con un mutex interno, por lo que el reloj se puede ajustar
+ * desde cualquier tarea. Las funciones que lo modifican no deben llamarse desde una interrupción
+ */
+bool ClockStartTickless(clock_t clock);
+
 /* === End of conditional blocks =================================================================================== */
 
 #ifdef __cplusplus
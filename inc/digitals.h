@@ -39,6 +39,9 @@ extern "C" {
 
 /* === Public macros definitions =================================================================================== */
 
+#define DIGITAL_OUTPUT_STORAGE_SIZE 8 //!< Cantidad de bytes que se reservan para crear una salida con DigitalOutputCreateStatic()
+#define DIGITAL_INPUT_STORAGE_SIZE  8 //!< Cantidad de bytes que se reservan para crear una entrada con DigitalInputCreateStatic()
+
 /* === Public data type declarations =============================================================================== */
 
 //! Tipo de dato que representa en cambio en el estado de un pin de entrada
@@ -54,10 +57,23 @@ typedef struct digital_output_s* digital_output_t;
 //! Estructura de datos que representa una Entrada Digital GPIO
 typedef struct digital_input_s* digital_input_t;
 
+//! Memoria en la que se puede crear una salida digital sin utilizar memoria dinámica (su contenido es privado del módulo)
+typedef union digital_output_storage_u {
+    uint8_t reserved[DIGITAL_OUTPUT_STORAGE_SIZE]; //!< Memoria reservada para los datos internos de la salida
+    uint32_t alignment;                            //!< Fuerza la alineación que requieren los datos internos de la salida
+} digital_output_storage_t;
+
+//! Memoria en la que se puede crear una entrada digital sin utilizar memoria dinámica (su contenido es privado del módulo)
+typedef union digital_input_storage_u {
+    uint8_t reserved[DIGITAL_INPUT_STORAGE_SIZE]; //!< Memoria reservada para los datos internos de la entrada
+    uint32_t alignment;                           //!< Fuerza la alineación que requieren los datos internos de la entrada
+} digital_input_storage_t;
+
 /* === Public variable declarations ================================================================================ */
 
 /* === Public function declarations ================================================================================ */
 
+#ifndef USE_STATIC_MEMORY
 /**
  * @brief Función que permite crear una Salida Digital GPIO
  *
@@ -67,6 +83,18 @@ typedef struct digital_input_s* digital_input_t;
  * @return digital_output_t Puntero a la estructura que contiene los datos de la salida digital
  */
 digital_output_t DigitalOutputCreate(uint8_t gpio_port, uint8_t gpio_bit, bool active_low);
+#endif
+
+/**
+ * @brief Función que permite crear una Salida Digital GPIO en una memoria reservada por la aplicación
+ *
+ * @param storage Memoria en la que se creará la salida. Debe existir mientras se utilice la salida
+ * @param gpio_port Puerto GPIO correspondiente a la salida digital
+ * @param gpio_bit Bit especiífico del puerto GPIO correspondiente a la salida digital
+ * @param active_low TRUE si es una salida activa en bajo; FALSE si es una salida activa en alto
+ * @return digital_output_t Puntero a la estructura que contiene los datos de la salida digital, o NULL si no se indicó la memoria
+ */
+digital_output_t DigitalOutputCreateStatic(digital_output_storage_t* storage, uint8_t gpio_port, uint8_t gpio_bit, bool active_low);
 
 /**
  * @brief Activa una salida digital GPIO
@@ -89,6 +117,7 @@ void DigitalOutputDeactivate(digital_output_t output);
  */
 void DigitalOutputToggle(digital_output_t output);
 
+#ifndef USE_STATIC_MEMORY
 /**
  * @brief Función que permite crear una Entrada Digital GPIO
  *
@@ -98,6 +127,18 @@ void DigitalOutputToggle(digital_output_t output);
  * @return digital_input_t  Puntero a la estructura que contiene los datos de la entrada digital
  */
 digital_input_t DigitalInputCreate(uint8_t gpio_port, uint8_t gpio_bit, bool inverted_logic);
+#endif
+
+/**
+ * @brief Función que permite crear una Entrada Digital GPIO en una memoria reservada por la aplicación
+ *
+ * @param storage Memoria en la que se creará la entrada. Debe existir mientras se utilice la entrada
+ * @param gpio_port Puerto GPIO correspondiente a la entrada digital
+ * @param gpio_bit Bit especiífico del puerto GPIO correspondiente a la entrada digital
+ * @param inverted_logic Determina si la entrada tiene lógica inversa o no
+ * @return digital_input_t Puntero a la estructura que contiene los datos de la entrada digital, o NULL si no se indicó la memoria
+ */
+digital_input_t DigitalInputCreateStatic(digital_input_storage_t* storage, uint8_t gpio_port, uint8_t gpio_bit, bool inverted_logic);
 
 /**
  * @brief Función que permite detectar si la entrada está activada
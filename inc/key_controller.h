@@ -22,16 +22,14 @@ SPDX-License-Identifier: MIT
 #define KEY_CONTROLLER_H
 
 /** @file key_controller.h
- ** @brief Cabecera del módulo de gestión del pulsado de las teclas
+ ** @brief Cabecera del módulo de gestión del pulsado de las teclas, que reconoce los gestos de cada tecla y los encola
  **/
 
 /* === Headers files inclusions ==================================================================================== */
 
-#include "FreeRTOS.h"
-#include "task.h"
-#include "event_groups.h"
-#include "digitals.h"
+#include "keyboard.h"
 #include <stdbool.h>
+#include <stdint.h>
 
 /* === Header for C++ compatibility ================================================================================ */
 
@@ -41,74 +39,140 @@ extern "C" {
 
 /* === Public macros definitions =================================================================================== */
 
-#define KEY_EVENT_KEY_0     (1 << 0) //!< Máscara que representa un bit en alto en la posición 0 del grupo de eventos
-#define KEY_EVENT_KEY_1     (1 << 1) //!< Máscara que representa un bit en alto en la posición 1 del grupo de eventos
-#define KEY_EVENT_KEY_2     (1 << 2) //!< Máscara que representa un bit en alto en la posición 2 del grupo de eventos
-#define KEY_EVENT_KEY_3     (1 << 3) //!< Máscara que representa un bit en alto en la posición 3 del grupo de eventos
-#define KEY_EVENT_KEY_4     (1 << 4) //!< Máscara que representa un bit en alto en la posición 4 del grupo de eventos
-#define KEY_EVENT_KEY_5     (1 << 5) //!< Máscara que representa un bit en alto en la posición 5 del grupo de eventos
-#define KEY_EVENT_KEY_6     (1 << 6) //!< Máscara que representa un bit en alto en la posición 6 del grupo de eventos
-#define KEY_EVENT_KEY_7     (1 << 7) //!< Máscara que representa un bit en alto en la posición 7 del grupo de eventos
-
-#define KEY_EVENT_ANY_KEY   0xFF //!< Máscara que representa un bit en alto en la posiciones 0 a 7 del grupo de eventos
+#ifndef KEY_CONTROLLER_QUEUE_LENGTH
+#define KEY_CONTROLLER_QUEUE_LENGTH 16 //!< Cantidad de eventos que puede guardar la cola sin que se consuman (como máximo 255)
+#endif
 
-#define KEY_TASK_STACK_SIZE (2 * configMINIMAL_STACK_SIZE) //!< Cantidad de memoria necesaria en la pila para las tareas de las teclas
+//! Cantidad de bytes que se reservan para crear un gestor de teclas con KeyControllerCreateStatic()
+#define KEY_CONTROLLER_STORAGE_SIZE (24 + 3 * sizeof(void*) + 8 * KEYBOARD_MAX_KEYS + 12 * KEY_CONTROLLER_QUEUE_LENGTH)
 
 /* === Public data type declarations =============================================================================== */
 
-//! Estructura de datos que representa un botón de la placa
-typedef struct button_s* button_t;
+//! Gestos que se reconocen en las teclas
+typedef enum key_gesture_e {
+    KEY_GESTURE_PRESS,        //!< La tecla se pulsó
+    KEY_GESTURE_RELEASE,      //!< La tecla se soltó
+    KEY_GESTURE_LONG_PRESS,   //!< La tecla se mantuvo pulsada el tiempo de pulsación larga (una vez por pulsación)
+    KEY_GESTURE_REPEAT,       //!< La tecla sigue pulsada y se cumplió un nuevo período de repetición
+    KEY_GESTURE_DOUBLE_CLICK, //!< La tecla se pulsó por segunda vez dentro del tiempo de doble pulsación
+} key_gesture_t;
+
+//! Estructura de datos que representa un evento de una tecla
+typedef struct key_event_s {
+    uint32_t timestamp;    //!< Cuenta de ticks de la lectura del teclado que produjo el evento
+    uint8_t key;           //!< Número de la tecla
+    uint8_t step;          //!< Unidades que representa el evento (mayor que 1 solo en las repeticiones aceleradas)
+    key_gesture_t gesture; //!< Gesto reconocido
+} key_event_t;
+
+//! Etapa de aceleración de la repetición automática de una tecla
+typedef struct key_repeat_stage_s {
+    uint32_t after_ticks;  //!< Tiempo de pulsación a partir del cual rige la etapa
+    uint32_t period_ticks; //!< Tiempo entre repeticiones durante la etapa (mayor que 0)
+    uint8_t step;          //!< Unidades que representa cada repetición durante la etapa (al menos 1)
+} key_repeat_stage_t;
+
+//! Estructura de datos con los tiempos (en ticks) con los que se reconocen los gestos de una tecla. En 0, el gesto no se usa
+typedef struct key_thresholds_s {
+    uint32_t long_press_ticks;              //!< Tiempo que debe mantenerse pulsada la tecla para una pulsación larga
+    uint32_t repeat_delay_ticks;            //!< Tiempo desde la pulsación hasta la primera repetición
+    uint32_t repeat_period_ticks;           //!< Tiempo entre repeticiones sucesivas (si es 0 se usa repeat_delay_ticks)
+    uint32_t double_click_ticks;            //!< Tiempo máximo entre dos pulsaciones para que formen una doble pulsación
+    const key_repeat_stage_t* acceleration; //!< Etapas de aceleración de la repetición, ordenadas por tiempo (NULL si no hay)
+    uint8_t acceleration_stages;            //!< Cantidad de etapas de aceleración
+} key_thresholds_t;
+
+//! Estructura de datos que representa un gestor de teclas
+typedef struct key_controller_s* key_controller_t;
+
+//! Memoria en la que se puede crear un gestor de teclas sin utilizar memoria dinámica (su contenido es privado del módulo)
+typedef union key_controller_storage_u {
+    uint8_t reserved[KEY_CONTROLLER_STORAGE_SIZE]; //!< Memoria reservada para los datos internos del gestor de teclas
+    void* alignment;                               //!< Fuerza la alineación que requieren los datos internos del gestor de teclas
+} key_controller_storage_t;
 
-//! Estructura de datos que representa los argumentos para las tareas al usar FreeRTOS
-typedef struct button_task_args_s{
-    EventGroupHandle_t event_group;  //!< Grupo de 32 bits que representan los posibles eventos
-    uint8_t event_mask;              //!< Máscara para representar un bit en particular del grupo de eventos
-    digital_input_t key;             //!< Tecla correspondiente a una entrada digital de la placa
-}* button_task_args_t;
+/**
+ * @brief Tipo de dato que representa la función a la que se avisa que hay nuevos eventos en la cola
+ *
+ * @param context Contexto indicado al registrar la función
+ */
+typedef void (*key_controller_sink_t)(void* context);
 
 /* === Public variable declarations ================================================================================ */
 
 /* === Public function declarations ================================================================================ */
 
+#ifndef USE_STATIC_MEMORY
+/**
+ * @brief Función que permite crear un gestor de teclas
+ *
+ * @param keys Arreglo con los tiempos de los gestos de cada tecla. Debe existir mientras se utilice el gestor
+ * @param count Cantidad de teclas (como máximo KEYBOARD_MAX_KEYS)
+ * @return key_controller_t Puntero a la estructura con los datos del gestor de teclas
+ */
+key_controller_t KeyControllerCreate(const key_thresholds_t keys[], uint8_t count);
+#endif
+
 /**
- * @brief Función que permite inicializar un botón
+ * @brief Función que permite crear un gestor de teclas en una memoria reservada por la aplicación
  *
- * @param key Puntero a la estructura con los datos de la tecla (digital_input_t)
- * @return button_t Puntero a la estructura con los datos del botón
+ * @param storage Memoria en la que se creará el gestor. Debe existir mientras se utilice el gestor
+ * @param keys Arreglo con los tiempos de los gestos de cada tecla. Debe existir mientras se utilice el gestor
+ * @param count Cantidad de teclas (como máximo KEYBOARD_MAX_KEYS)
+ * @return key_controller_t Puntero a la estructura con los datos del gestor, o NULL si no se indicó la memoria
  */
-button_t ButtonCreate(digital_input_t key);
+key_controller_t KeyControllerCreateStatic(key_controller_storage_t* storage, const key_thresholds_t keys[], uint8_t count);
 
 /**
- * @brief Función que permite saber si un botón fue pulsado por 3 segundos o mas. Debe llamarse cada 1ms
+ * @brief Función que permite registrar la función a la que se avisa cuando se encolan nuevos eventos
  *
- * @param button Puntero a la estructura con los datos de la tecla
- * @return true Si el botón fue pulsado por 3 segundos o más
- * @return false Si el botón NO fue pulsado por 3 segundos o más
+ * @param controller Puntero a la estructura con los datos del gestor de teclas
+ * @param sink Función que se llama luego de encolar eventos (NULL para no avisar)
+ * @param context Contexto que se le pasa a la función en cada llamada
  */
-bool ButtonWasPressed3secs(button_t button);
+void KeyControllerSetNotificationSink(key_controller_t controller, key_controller_sink_t sink, void* context);
 
 /**
- * @brief Función que permite saber si un botón fue pulsado
+ * @brief Función que reconoce los gestos de las teclas a partir de una lectura del teclado y los encola
+ *
+ * @param controller Puntero a la estructura con los datos del gestor de teclas
+ * @param events Eventos producidos por la lectura del teclado
+ * @param now Cuenta de ticks en la que se tomó la lectura
  *
- * @param button Puntero a la estructura con los datos de la tecla
- * @return true Si el botón fue pulsado
- * @return false Si el botón no fue pulsado
+ * NOTA: La pulsación se informa de inmediato; si además completa una doble pulsación, se encola a continuación el
+ * evento KEY_GESTURE_DOUBLE_CLICK. Cada repetición usa el período y las unidades de la última etapa de aceleración
+ * alcanzada por el tiempo de pulsación. Si la cola está llena, los eventos nuevos se descartan y se cuentan como perdidos
  */
-bool ButtonWasPressed(button_t button);
+void KeyControllerProcess(key_controller_t controller, const keyboard_events_t* events, uint32_t now);
 
 /**
- * @brief Tarea que genera un evento cuando se pulsa una tecla (con antirrebote) al usar FreeRTOS
- * 
- * @param arguments Argumentos necesarios para la tarea.
+ * @brief Función que saca de la cola el evento más antiguo
+ *
+ * @param controller Puntero a la estructura con los datos del gestor de teclas
+ * @param event Puntero donde se guardará el evento
+ * @return true Si había un evento en la cola
+ * @return false Si la cola estaba vacía
+ *
+ * NOTA: La cola admite una única tarea que encola (la del teclado) y una única tarea que consume, sin bloqueos
  */
-void ButtonPressedTask(void *arguments);
+bool KeyControllerGetEvent(key_controller_t controller, key_event_t* event);
 
 /**
- * @brief Tarea que genera un evento cuando se pulsa una tecla 3 segundos, al usar FreeRTOS
- * 
- * @param arguments Argumentos necesarios para la tarea.
+ * @brief Función que devuelve la cantidad de eventos descartados por encontrar la cola llena
+ *
+ * @param controller Puntero a la estructura con los datos del gestor de teclas
+ * @return uint32_t Cantidad de eventos perdidos desde que se creó el gestor
+ */
+uint32_t KeyControllerGetLostEvents(key_controller_t controller);
+
+/**
+ * @brief Función que recibe las lecturas de la tarea del teclado (keyboard_handler_t) y las pasa al gestor de teclas
+ *
+ * @param controller Gestor de teclas (se recibe como void* para poder usarse como contexto de la tarea del teclado)
+ * @param events Eventos producidos por la lectura del teclado
+ * @param now Cuenta de ticks en la que se tomó la lectura
  */
-void ButtonPressed3secsTask(void *arguments);
+void KeyControllerKeyboardHandler(void* controller, const keyboard_events_t* events, uint32_t now);
 
 /* === End of conditional blocks =================================================================================== */
 
@@ -0,0 +1,168 @@
+/*********************************************************************************************************************
+Copyright (c) 2025, Facundo Sonzogni <facundosonzogni1@gmail.com>
+Copyright (c) 2025, Laboratorio de Microprocesadores, Universidad Nacional de Tucumán
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*********************************************************************************************************************/
+
+#ifndef KEYBOARD_H
+#define KEYBOARD_H
+
+/** @file keyboard.h
+ ** @brief Cabecera del módulo de Teclado, que lee todas las teclas de una vez y las procesa con antirrebote
+ **/
+
+/* === Headers files inclusions ==================================================================================== */
+
+#include "FreeRTOS.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/* === Header for C++ compatibility ================================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =================================================================================== */
+
+#ifndef KEYBOARD_MAX_KEYS
+#define KEYBOARD_MAX_KEYS        8 //!< Cantidad máxima de teclas que puede tener un teclado (entre 1 y 32)
+#endif
+
+#if (KEYBOARD_MAX_KEYS < 1) || (KEYBOARD_MAX_KEYS > 32)
+#error "KEYBOARD_MAX_KEYS debe estar entre 1 y 32"
+#endif
+
+#define KEYBOARD_SCAN_PERIOD_MS  5                        //!< Período de lectura de las teclas mientras hay actividad en el teclado
+#define KEYBOARD_DEBOUNCE_SCANS  4                        //!< Lecturas seguidas necesarias para aceptar un cambio (fijo, por los contadores de dos bits)
+#define KEYBOARD_TASK_STACK_SIZE configMINIMAL_STACK_SIZE //!< Cantidad de memoria necesaria en la pila para la tarea del teclado
+
+//! Cantidad de bytes que se reservan para crear un teclado con KeyboardCreateStatic()
+#define KEYBOARD_STORAGE_SIZE    (24 + sizeof(void*))
+
+/* === Public data type declarations =============================================================================== */
+
+//! Estructura de datos que representa un Teclado
+typedef struct keyboard_s* keyboard_t;
+
+//! Memoria en la que se puede crear un teclado sin utilizar memoria dinámica (su contenido es privado del módulo)
+typedef union keyboard_storage_u {
+    uint8_t reserved[KEYBOARD_STORAGE_SIZE]; //!< Memoria reservada para los datos internos del teclado
+    void* alignment;                         //!< Fuerza la alineación que requieren los datos internos del teclado
+} keyboard_storage_t;
+
+//! Eventos producidos por una lectura del teclado, un bit por tecla (el bit N corresponde a la tecla N)
+typedef struct keyboard_events_s {
+    uint32_t pressed;  //!< Teclas que se pulsaron
+    uint32_t released; //!< Teclas que se soltaron
+    uint32_t down;     //!< Teclas que están pulsadas luego de la lectura
+} keyboard_events_t;
+
+/**
+ * @brief Tipo de dato que representa la función que lee el estado de todas las teclas de una sola vez
+ *
+ * @return uint32_t Estado de las teclas, un bit por tecla (en 1 si la tecla está pulsada)
+ */
+typedef uint32_t (*keyboard_read_t)(void);
+
+/**
+ * @brief Tipo de dato que representa la función a la que la tarea del teclado entrega el resultado de cada lectura
+ *
+ * @param context Contexto indicado en los argumentos de la tarea
+ * @param events Eventos producidos por la lectura
+ * @param now Cuenta de ticks en la que se tomó la lectura
+ */
+typedef void (*keyboard_handler_t)(void* context, const keyboard_events_t* events, uint32_t now);
+
+//! Estructura de datos que representa los argumentos de la tarea del teclado
+typedef struct keyboard_task_args_s {
+    keyboard_t keyboard;        //!< Teclado que procesa la tarea
+    keyboard_read_t read;       //!< Función que lee el estado de todas las teclas
+    keyboard_handler_t handler; //!< Función que recibe el resultado de cada lectura
+    void* context;              //!< Contexto que se le pasa a la función que recibe las lecturas
+}* keyboard_task_args_t;
+
+/* === Public variable declarations ================================================================================ */
+
+/* === Public function declarations ================================================================================ */
+
+#ifndef USE_STATIC_MEMORY
+/**
+ * @brief Función que permite crear un teclado
+ *
+ * @param count Cantidad de teclas (como máximo KEYBOARD_MAX_KEYS)
+ * @return keyboard_t Puntero a la estructura con los datos del teclado
+ */
+keyboard_t KeyboardCreate(uint8_t count);
+#endif
+
+/**
+ * @brief Función que permite crear un teclado en una memoria reservada por la aplicación
+ *
+ * @param storage Memoria en la que se creará el teclado. Debe existir mientras se utilice el teclado
+ * @param count Cantidad de teclas (como máximo KEYBOARD_MAX_KEYS)
+ * @return keyboard_t Puntero a la estructura con los datos del teclado, o NULL si no se indicó la memoria
+ */
+keyboard_t KeyboardCreateStatic(keyboard_storage_t* storage, uint8_t count);
+
+/**
+ * @brief Función que procesa una lectura de todas las teclas, con antirrebote para todas a la vez
+ *
+ * @param keyboard Puntero a la estructura con los datos del teclado
+ * @param sample Estado leído de las teclas, un bit por tecla (en 1 si la tecla está pulsada)
+ * @param events Puntero donde se guardarán los eventos producidos por esta lectura
+ *
+ * NOTA: El antirrebote usa contadores verticales: cada bit de dos palabras forma el contador de dos bits de una
+ * tecla, de modo que todas las teclas se procesan con unas pocas operaciones lógicas, sin importar cuántas sean.
+ * Una tecla cambia de estado luego de KEYBOARD_DEBOUNCE_SCANS lecturas consecutivas distintas a su estado actual
+ */
+void KeyboardScan(keyboard_t keyboard, uint32_t sample, keyboard_events_t* events);
+
+/**
+ * @brief Función que permite saber si el teclado está en reposo: todas las teclas sueltas y sin rebotes pendientes
+ *
+ * @param keyboard Puntero a la estructura con los datos del teclado
+ * @return true Si no es necesario seguir leyendo las teclas hasta la próxima interrupción
+ * @return false Si hay alguna tecla pulsada o cambiando de estado
+ */
+bool KeyboardIsIdle(keyboard_t keyboard);
+
+/**
+ * @brief Función que despierta a la tarea del teclado desde la interrupción de una tecla
+ *
+ * @param keyboard Teclado (se recibe como void* para poder usarse como función de callback de la placa)
+ */
+void KeyboardWakeFromISR(void* keyboard);
+
+/**
+ * @brief Tarea que lee y procesa el teclado y entrega el resultado de cada lectura a una función, al usar FreeRTOS
+ *
+ * @param arguments Argumentos de la tarea (keyboard_task_args_t)
+ *
+ * NOTA: Mientras el teclado está en reposo la tarea permanece bloqueada hasta que la interrupción de una tecla la
+ * despierta. Mientras hay actividad lee todas las teclas cada KEYBOARD_SCAN_PERIOD_MS, por lo que la función que
+ * recibe las lecturas también puede medir el tiempo que una tecla permanece pulsada
+ */
+void KeyboardTask(void* arguments);
+
+/* === End of conditional blocks =================================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* KEYBOARD_H */
@@ -0,0 +1,177 @@
+/*********************************************************************************************************************
+Copyright (c) 2025, Facundo Sonzogni <facundosonzogni1@gmail.com>
+Copyright (c) 2025, Laboratorio de Microprocesadores, Universidad Nacional de Tucumán
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*********************************************************************************************************************/
+
+
+#ifndef MEF_H
+#define MEF_H
+
+/** @file mef.h
+ ** @brief Cabecera del núcleo de la Máquina de Estado Finito del reloj despertador, independiente de FreeRTOS
+ **/
+
+/* === Headers files inclusions ==================================================================================== */
+
+#include "clock.h"
+#include "screen.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/* === Header for C++ compatibility ================================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =================================================================================== */
+
+#define MEF_NO_TIMEOUT   0xFFFFFFFFU //!< Indica que no hay tiempo límite, en MEFSetTimeout() y en MEFGetTicksToTimeout()
+
+//! Cantidad de bytes que se reservan para crear una MEF con MEFCreateStatic()
+#define MEF_STORAGE_SIZE (44 + 4 * MEF_STATE_COUNT + 2 * sizeof(void*))
+
+/* === Public data type declarations =============================================================================== */
+
+//! Tipo de dato que representa el estado de la MEF del reloj
+typedef enum mef_state_e {
+    MEF_STATE_UNCHANGED,               //!< Indica, en la tabla de transiciones, que la entrada no cambia el estado (no es un estado)
+    MEF_STATE_INVALID_TIME,            //!< Indica que la hora es inválida
+    MEF_STATE_SHOWING_CURRENT_TIME,    //!< Indica que se está mostrando la hora actual
+    MEF_STATE_ADJUSTING_TIME_MINUTES,  //!< Indica que se están ajustando los minutos
+    MEF_STATE_ADJUSTING_TIME_HOURS,    //!< Indica que se están ajustando las horas
+    MEF_STATE_ADJUSTING_ALARM_MINUTES, //!< Indica que se están ajustando los minutos de la alarma
+    MEF_STATE_ADJUSTING_ALARM_HOURS,   //!< Indica que se están ajustando las horas de la alarma
+    MEF_STATE_COUNT,                   //!< Cantidad de estados (no es un estado)
+} mef_state_t;
+
+//! Tipo de dato que representa las entradas que hacen avanzar a la MEF
+typedef enum mef_input_e {
+    MEF_INPUT_NONE,         //!< Sin entrada: solo pasa el tiempo (por ejemplo, un gesto de una tecla que la MEF no utiliza)
+    MEF_INPUT_SET_TIME,     //!< Pulsación larga de la tecla "set_time"
+    MEF_INPUT_SET_ALARM,    //!< Pulsación larga de la tecla "set_alarm"
+    MEF_INPUT_INCREMENT,    //!< Pulsación o repetición de la tecla "increment"
+    MEF_INPUT_DECREMENT,    //!< Pulsación o repetición de la tecla "decrement"
+    MEF_INPUT_ACCEPT,       //!< Pulsación de la tecla "accept"
+    MEF_INPUT_CANCEL,       //!< Pulsación de la tecla "cancel"
+    MEF_INPUT_TIMEOUT,      //!< Se cumplió el tiempo sin pulsaciones del estado actual
+    MEF_INPUT_CLOCK_MINUTE, //!< El reloj pasó a un nuevo minuto
+    MEF_INPUT_COUNT,        //!< Cantidad de entradas (no es una entrada)
+} mef_input_t;
+
+//! Estructura de datos que representa un evento que se entrega a la MEF
+typedef struct mef_event_s {
+    mef_input_t input; //!< Entrada que produce el evento
+    uint8_t step;      //!< Unidades que avanzan "increment" y "decrement" (1, o más en una repetición acelerada)
+} mef_event_t;
+
+//! Estructura de datos que representa la MEF del reloj despertador
+typedef struct mef_s* mef_t;
+
+//! Memoria en la que se puede crear una MEF sin utilizar memoria dinámica (su contenido es privado del módulo)
+typedef union mef_storage_u {
+    uint8_t reserved[MEF_STORAGE_SIZE]; //!< Memoria reservada para los datos internos de la MEF
+    void* alignment;                    //!< Fuerza la alineación que requieren los datos internos de la MEF
+} mef_storage_t;
+
+/* === Public variable declarations ================================================================================ */
+
+/* === Public function declarations ================================================================================ */
+
+#ifndef USE_STATIC_MEMORY
+/**
+ * @brief Función que permite crear la MEF del reloj despertador
+ *
+ * @param clock Reloj cuya hora y alarma se muestran y se ajustan
+ * @param screen Pantalla en la que se dibuja cada estado
+ * @param timeout Tiempo sin pulsaciones, en ticks, de todos los estados que lo atienden (ver MEFSetTimeout())
+ * @return mef_t Puntero a la estructura con los datos de la MEF
+ */
+mef_t MEFCreate(clock_t clock, screen_t screen, uint32_t timeout);
+#endif
+
+/**
+ * @brief Función que permite crear la MEF del reloj despertador en una memoria reservada por la aplicación
+ *
+ * @param storage Memoria en la que se creará la MEF. Debe existir mientras se utilice la MEF
+ * @param clock Reloj cuya hora y alarma se muestran y se ajustan
+ * @param screen Pantalla en la que se dibuja cada estado
+ * @param timeout Tiempo sin pulsaciones, en ticks, de todos los estados que lo atienden (ver MEFSetTimeout())
+ * @return mef_t Puntero a la estructura con los datos de la MEF, o NULL si no se indicó la memoria
+ */
+mef_t MEFCreateStatic(mef_storage_t* storage, clock_t clock, screen_t screen, uint32_t timeout);
+
+/**
+ * @brief Función que pone en marcha la MEF: muestra la hora actual, o la hora inválida si el reloj no tiene hora
+ *
+ * @param mef Puntero a la estructura con los datos de la MEF
+ * @param now Cuenta de ticks actual
+ */
+void MEFStart(mef_t mef, uint32_t now);
+
+/**
+ * @brief Función que hace avanzar a la MEF con un evento
+ *
+ * @param mef Puntero a la estructura con los datos de la MEF
+ * @param event Evento que se atiende (MEF_INPUT_NONE si solo pasó el tiempo)
+ * @param now Cuenta de ticks actual, en la misma base de tiempo en la que se indicó el tiempo sin pulsaciones
+ *
+ * NOTA: La función no lee ninguna base de tiempo ni se bloquea: el tiempo solo avanza a través de "now", por lo que la
+ * MEF puede ejecutarse fuera de FreeRTOS. Si el tiempo sin pulsaciones del estado actual ya se cumplió, se atiende
+ * antes que el evento, y una sola vez: el plazo solo se vuelve a armar al cambiar de estado o al atender una pulsación
+ */
+void MEFStep(mef_t mef, const mef_event_t* event, uint32_t now);
+
+/**
+ * @brief Función que permite saber cuánto falta para que se cumpla el tiempo sin pulsaciones del estado actual
+ *
+ * @param mef Puntero a la estructura con los datos de la MEF
+ * @param now Cuenta de ticks actual
+ * @return uint32_t Ticks que faltan (0 si ya se cumplió), o MEF_NO_TIMEOUT si el estado no tiene tiempo límite
+ *
+ * NOTA: Es el tiempo máximo que puede esperarse el próximo evento antes de volver a llamar a MEFStep()
+ */
+uint32_t MEFGetTicksToTimeout(mef_t mef, uint32_t now);
+
+/**
+ * @brief Función que permite configurar el tiempo sin pulsaciones de un estado
+ *
+ * @param mef Puntero a la estructura con los datos de la MEF
+ * @param state Estado que se configura
+ * @param timeout Tiempo sin pulsaciones, en ticks, o MEF_NO_TIMEOUT para que el estado no tenga tiempo límite
+ *
+ * NOTA: Solo tienen tiempo límite los estados que atienden MEF_INPUT_TIMEOUT (los de ajuste). El tiempo nuevo se
+ * aplica a partir de la próxima vez que se arme el plazo del estado: al entrar a él o al atender una pulsación
+ */
+void MEFSetTimeout(mef_t mef, mef_state_t state, uint32_t timeout);
+
+/**
+ * @brief Función que permite obtener el estado actual de la MEF
+ *
+ * @param mef Puntero a la estructura con los datos de la MEF
+ * @return mef_state_t Estado actual (MEF_STATE_UNCHANGED si no se indicó la MEF)
+ */
+mef_state_t MEFGetState(mef_t mef);
+
+/* === End of conditional blocks =================================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MEF_H */
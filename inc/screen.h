@@ -48,11 +48,39 @@ extern "C" {
 #define SEGMENT_G (1 << 6)
 #define SEGMENT_P (1 << 7)
 
+#define SCREEN_GLYPH_BLANK 0x00      //!< Segmentos de un dígito en blanco
+#define SCREEN_GLYPH_MINUS SEGMENT_G //!< Segmentos del signo menos
+
+#ifndef SCREEN_MAX_DIGITS
+#define SCREEN_MAX_DIGITS 8 //!< Cantidad máxima de dígitos que puede tener una pantalla
+#endif
+
+#define SCREEN_REFRESH_FREQUENCY 1000 //!< Cantidad de dígitos por segundo que se refrescan (un dígito cada 1 ms)
+
+#define SCREEN_BRIGHTNESS_LEVELS 16      //!< Cantidad de niveles de brillo de cada dígito
+#define SCREEN_BRIGHTNESS_MAX    15      //!< Nivel de brillo máximo (el display encendido todo su intervalo)
+#define SCREEN_DUTY_FULL         0xFFFFU //!< Fracción del intervalo de un dígito que corresponde a tenerlo siempre encendido
+
+#define SCREEN_MARQUEE_MAX_LENGTH (0xFFFFU - SCREEN_MAX_DIGITS) //!< Cantidad máxima de dígitos de un mensaje que se desplaza
+
+//! Cantidad de bytes que se reservan para crear una pantalla con ScreenCreateStatic()
+#define SCREEN_STORAGE_SIZE (36 + 9 * SCREEN_MAX_DIGITS + 4 * sizeof(void*))
+
 /* === Public data type declarations =============================================================================== */
 
 //! Estructura de datos que representa una Pantalla de displays 7 segmentos
 typedef struct screen_s* screen_t;
 
+/**
+ * @brief Memoria en la que se puede crear una pantalla con ScreenCreateStatic(), sin utilizar memoria dinámica
+ *
+ * NOTA: Su contenido es privado del módulo
+ */
+typedef union screen_storage_u {
+    uint8_t reserved[SCREEN_STORAGE_SIZE]; //!< Memoria reservada para los datos internos de la pantalla
+    void* alignment;                       //!< Fuerza la alineación que requieren los datos internos de la pantalla
+} screen_storage_t;
+
 //! Tipo de dato que representa una función que permite apagar todos los habilitadores de los displays
 typedef void (*digits_turn_off_t)(void);
 
@@ -62,17 +90,44 @@ typedef void (*segments_update_t)(uint8_t);
 //! Tipo de dato que representa una función que permite encender un display específico de la pantalla
 typedef void (*digit_turn_on)(uint8_t);
 
+//! Tipo de dato que representa una función que apaga el display encendido luego de una fracción (sobre SCREEN_DUTY_FULL)
+//! del intervalo de su dígito
+typedef void (*digit_dim_t)(uint16_t);
+
+//! Modos de desplazamiento de un mensaje por la pantalla
+typedef enum screen_marquee_mode_e {
+    SCREEN_MARQUEE_ONCE, //!< El mensaje pasa una sola vez y luego se vuelve a mostrar la memoria de video
+    SCREEN_MARQUEE_LOOP, //!< El mensaje se repite hasta que se detiene con ScreenMarqueeStop()
+} screen_marquee_mode_t;
+
+/**
+ * @brief Tipo de dato que representa la función que avisa que terminó un mensaje de una sola pasada
+ *
+ * @param context Contexto indicado al configurar el aviso
+ *
+ * NOTA: Se llama desde el refresco de la pantalla, que puede ser la interrupción de un temporizador
+ */
+typedef void (*screen_marquee_done_t)(void* context);
+
 /*! Estructura de datos que representa el driver de la pantalla con las funciones de callback */
 typedef struct screen_driver_s {
     digits_turn_off_t DigitsTurnOff;  //!< Función que permite apagar todos los habilitadores de los displays
     segments_update_t SegmentsUpdate; //!< Función que permite modificar los segmentos de un correspondiente display para escribir un número en la pantalla
     digit_turn_on DigitTurnOn;        //!< Función que permite encender un display específico de la pantalla
+    digit_dim_t DigitDim;             //!< Función opcional que acorta el encendido del display para atenuarlo (NULL si no se puede)
 } const* screen_driver_t;
 
+//! Contadores de las actualizaciones de la pantalla, para medir cuántas llamadas no modifican nada
+typedef struct screen_stats_s {
+    uint32_t accepted; //!< Actualizaciones que modificaron el contenido o el parpadeo (coincide con la generación)
+    uint32_t elided;   //!< Actualizaciones descartadas porque pedían lo mismo que ya se mostraba
+} screen_stats_t;
+
 /* === Public variable declarations ================================================================================ */
 
 /* === Public function declarations ================================================================================ */
 
+#ifndef USE_STATIC_MEMORY
 /**
  * @brief Función que permite crear una pantalla de displays 7 segmentos
  *
@@ -81,6 +136,17 @@ typedef struct screen_driver_s {
  * @return screen_t Puntero a la estructura con los datos de la pantalla creada
  */
 screen_t ScreenCreate(uint8_t digits, screen_driver_t driver);
+#endif
+
+/**
+ * @brief Función que permite crear una pantalla de displays 7 segmentos en una memoria reservada por la aplicación
+ *
+ * @param storage Memoria en la que se creará la pantalla. Debe existir mientras se utilice la pantalla
+ * @param digits Cantidad de dígitos que tendrá la pantalla (es decir, cantidad de displays que forman la pantalla)
+ * @param driver Driver con las funciones de callback, que utilizan las funciones del fabricante
+ * @return screen_t Puntero a la estructura con los datos de la pantalla creada, o NULL si no se indicó la memoria
+ */
+screen_t ScreenCreateStatic(screen_storage_t* storage, uint8_t digits, screen_driver_t driver);
 
 /**
  * @brief Función que permite escribir un número en código BCD en la pantalla
@@ -88,13 +154,53 @@ screen_t ScreenCreate(uint8_t digits, screen_driver_t driver);
  * @param screen Puntero a la estructura con los datos de la pantalla que se quiere escribir
  * @param value Arreglo en el que cada elemento es un dígito a mostrar codificado en BCD
  * @param size Cantidad de dígitos que se quiere que tenga la pantalla
+ *
+ * NOTA: Los valores del 10 al 15 se muestran como dígitos hexadecimales, y los mayores se muestran en blanco
  */
 void ScreenWriteBCD(screen_t screen, uint8_t value[], uint8_t size);
 
+/**
+ * @brief Función que permite escribir directamente los segmentos de varios dígitos de la pantalla en una sola llamada
+ *
+ * @param screen Puntero a la estructura con los datos de la pantalla
+ * @param glyphs Segmentos de cada dígito (SEGMENT_A a SEGMENT_P), comenzando por el MSB
+ * @param size Cantidad de dígitos a escribir. Los restantes quedan en blanco, conservando sus puntos, igual que con
+ * ScreenWriteBCD()
+ */
+void ScreenWriteGlyphs(screen_t screen, const uint8_t glyphs[], uint8_t size);
+
+/**
+ * @brief Función que permite escribir un texto en la pantalla, por ejemplo "AL", "SnZ" o "Err"
+ *
+ * @param screen Puntero a la estructura con los datos de la pantalla
+ * @param text Texto terminado en cero, que se escribe desde el MSB. Un punto se muestra en el dígito anterior
+ * @return int 0 si se mostró el texto completo. -1 si no se indicó el texto o si no entró en la pantalla (en ese caso se
+ * muestran sus primeros caracteres)
+ *
+ * NOTA: Se muestran los dígitos, los signos "-", "_" y "=", y las letras que se pueden representar en 7 segmentos; los
+ * demás caracteres se muestran en blanco
+ */
+int ScreenWriteText(screen_t screen, const char* text);
+
+/**
+ * @brief Función que convierte un texto en los segmentos de cada dígito, con las mismas reglas que ScreenWriteText()
+ *
+ * @param text Texto terminado en cero
+ * @param glyphs Arreglo donde se guardan los segmentos de cada dígito
+ * @param size Cantidad de elementos del arreglo. Con 0 solo se calcula cuántos dígitos ocupa el texto
+ * @return uint16_t Cantidad de dígitos que ocupa el texto completo (si es mayor que size, solo se guardan los primeros)
+ */
+uint16_t ScreenTextToGlyphs(const char* text, uint8_t glyphs[], uint16_t size);
+
 /**
  * @brief Función de Tick que debe incluirse en un lazo externo para el refresco de la pantalla
  *
  * @param screen Puntero a la estructura con los datos de la pantalla
+ *
+ * NOTA: Las funciones que escriben la pantalla o configuran los parpadeos solo avisan que hubo un cambio. Al comenzar
+ * cada cuadro (cuando se vuelve a mostrar el primer dígito) se compilan los segmentos de todos los displays, pero
+ * solo si hubo un cambio o si algún parpadeo cambia de fase; en el resto de las llamadas se envía el valor ya compilado,
+ * con un costo que no depende de la cantidad de dígitos ni de los parpadeos configurados
  */
 void ScreenRefresh(screen_t screen);
 
@@ -140,10 +246,109 @@ void ScreenSetDotState(screen_t screen, uint8_t digit, bool turn_on);
  */
 int ScreenFlashDot(screen_t screen, uint8_t digit, uint16_t half_period);
 
+/**
+ * @brief Función que permite configurar el brillo de todos los dígitos de la pantalla
+ *
+ * @param screen Puntero a la estructura con los datos de la pantalla
+ * @param level Nivel de brillo, entre 0 (apagado) y SCREEN_BRIGHTNESS_MAX (máximo, el valor inicial)
+ * @return int 0 si fue posible configurar el brillo. -1 si el nivel no es válido
+ *
+ * NOTA: El brillo se obtiene encendiendo cada display solo una parte del intervalo de su dígito, según una tabla con
+ * corrección gamma para que los niveles se perciban equiespaciados. Si el driver no tiene la función DigitDim los
+ * niveles intermedios se muestran con el brillo máximo; el nivel 0 siempre apaga los segmentos y no consume corriente
+ */
+int ScreenSetBrightness(screen_t screen, uint8_t level);
+
+/**
+ * @brief Función que permite configurar el brillo de uno de los dígitos de la pantalla, por ejemplo para igualarlos
+ *
+ * @param screen Puntero a la estructura con los datos de la pantalla
+ * @param digit Número del dígito que se quiere configurar (0 para el LSB)
+ * @param level Nivel de brillo, entre 0 (apagado) y SCREEN_BRIGHTNESS_MAX (máximo)
+ * @return int 0 si fue posible configurar el brillo. -1 si el dígito o el nivel no son válidos
+ */
+int ScreenSetDigitBrightness(screen_t screen, uint8_t digit, uint8_t level);
+
+/**
+ * @brief Función que comienza a desplazar un mensaje de cualquier longitud por la pantalla, de derecha a izquierda
+ *
+ * @param screen Puntero a la estructura con los datos de la pantalla
+ * @param glyphs Segmentos de cada dígito del mensaje (por ejemplo, obtenidos con ScreenTextToGlyphs()). La memoria debe
+ * existir y no modificarse mientras se desplaza el mensaje
+ * @param length Cantidad de dígitos del mensaje (como máximo SCREEN_MARQUEE_MAX_LENGTH)
+ * @param step Cantidad de ciclos (cuadros) que se muestra cada posición del mensaje
+ * @param mode Indica si el mensaje pasa una sola vez o se repite
+ * @return int 0 si comenzó el desplazamiento. -1 si los argumentos no son válidos
+ *
+ * NOTA: El primer dígito del mensaje aparece de inmediato a la derecha y la pasada termina cuando el último sale por la
+ * izquierda. Mientras tanto se reemplaza lo escrito en la pantalla, pero se mantienen los parpadeos y el brillo.
+ * La ventana visible se compila solo en cada desplazamiento, por lo que el refresco no tiene trabajo adicional
+ */
+int ScreenMarqueeStart(screen_t screen, const uint8_t glyphs[], uint16_t length, uint16_t step, screen_marquee_mode_t mode);
+
+/**
+ * @brief Función que detiene el mensaje que se desplaza y vuelve a mostrar lo escrito en la pantalla
+ *
+ * @param screen Puntero a la estructura con los datos de la pantalla
+ *
+ * NOTA: Al detenerlo no se llama a la función que avisa el final del mensaje
+ */
+void ScreenMarqueeStop(screen_t screen);
+
+/**
+ * @brief Función que permite saber si se está desplazando un mensaje por la pantalla
+ *
+ * @param screen Puntero a la estructura con los datos de la pantalla
+ * @return true Si hay un mensaje desplazándose
+ * @return false Si terminó o se detuvo, y la pantalla muestra lo escrito en ella
+ */
+bool ScreenMarqueeIsRunning(screen_t screen);
+
+/**
+ * @brief Función que configura la función que avisa que terminó de pasar un mensaje de una sola pasada
+ *
+ * @param screen Puntero a la estructura con los datos de la pantalla
+ * @param done Función que se llama al terminar el mensaje (NULL para no recibir avisos)
+ * @param context Contexto que se le pasa a la función en cada llamada
+ */
+void ScreenSetMarqueeSink(screen_t screen, screen_marquee_done_t done, void* context);
+
+/**
+ * @brief Función que devuelve la generación de la pantalla, que aumenta en cada actualización que modifica algo
+ *
+ * @param screen Puntero a la estructura con los datos de la pantalla
+ * @return uint32_t Generación actual. Si no cambió entre dos lecturas, la pantalla muestra lo mismo
+ *
+ * NOTA: Las funciones que escriben la pantalla o configuran los parpadeos comparan lo pedido con lo que ya se muestra,
+ * y si no hay diferencias descartan la llamada sin avisar a la función de refresco ni aumentar la generación
+ */
+uint32_t ScreenGetGeneration(screen_t screen);
+
+/**
+ * @brief Función que permite leer los contadores de actualizaciones aceptadas y descartadas de la pantalla
+ *
+ * @param screen Puntero a la estructura con los datos de la pantalla
+ * @param stats Puntero donde se guardarán los contadores
+ */
+void ScreenGetStats(screen_t screen, screen_stats_t* stats);
+
+/**
+ * @brief Función que refresca la pantalla desde la interrupción de un temporizador periódico
+ *
+ * @param screen Pantalla (se recibe como void* para poder usarse como función de callback de la placa)
+ *
+ * NOTA: No utiliza funciones de FreeRTOS, por lo que el barrido no depende del planificador ni necesita una tarea.
+ * El temporizador debe interrumpir una vez por dígito (por ejemplo, cada 1 ms con SCREEN_REFRESH_FREQUENCY)
+ */
+void ScreenRefreshFromISR(void* screen);
+
 /**
  * @brief Tarea para implementar el refresco de pantalla utilizando FreeRTOS
  *
  * @param screen Puntero con los datos de la pantalla
+ *
+ * NOTA: Es la alternativa a ScreenRefreshFromISR() cuando no hay un temporizador disponible. Cada dígito cuesta un
+ * cambio de contexto y la demora en refrescarlo depende de las demás tareas de mayor o igual prioridad
  */
 void ScreenRefreshTask(void* screen);
 
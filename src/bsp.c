@@ -36,6 +36,42 @@ SPDX-License-Identifier: MIT
 
 /* === Macros definitions ========================================================================================== */
 
+#define KEYS_GPIO   KEY_F1_GPIO //!< Puerto GPIO en el que están todas las teclas del poncho
+#define KEYS_F_MASK 0x0FU       //!< Bits de las teclas F1 a F4 luego de trasladarlas al bit BOARD_KEY_F1
+
+#define SCREEN_DIGITS      4             //!< Cantidad de displays de la pantalla del poncho
+#define SCREEN_TIMER       LPC_TIMER0    //!< Temporizador que marca el barrido de la pantalla
+#define SCREEN_TIMER_CLOCK CLK_MX_TIMER0 //!< Reloj del temporizador de la pantalla
+#define SCREEN_TIMER_IRQ   TIMER0_IRQn   //!< Interrupción del temporizador de la pantalla
+#define SCREEN_TIMER_MATCH 0             //!< Registro de coincidencia que fija el período del temporizador de la pantalla
+#define SCREEN_DIM_MATCH   1             //!< Registro de coincidencia que apaga el display atenuado dentro de su intervalo
+
+#if (KEY_F2_GPIO != KEYS_GPIO) || (KEY_F3_GPIO != KEYS_GPIO) || (KEY_F4_GPIO != KEYS_GPIO) || (KEY_ACCEPT_GPIO != KEYS_GPIO) || (KEY_CANCEL_GPIO != KEYS_GPIO)
+#error "BoardReadKeys() supone que todas las teclas están en el mismo puerto GPIO"
+#endif
+
+#if (KEY_F2_BIT != KEY_F1_BIT + 1) || (KEY_F3_BIT != KEY_F1_BIT + 2) || (KEY_F4_BIT != KEY_F1_BIT + 3) || (BOARD_KEY_F1 != 0) || (BOARD_KEY_F4 != 3)
+#error "BoardReadKeys() supone que las teclas F1 a F4 ocupan bits consecutivos del puerto y los números de tecla 0 a 3"
+#endif
+
+#if (SEGMENTS_GPIO == SEGMENT_P_GPIO) || (SEGMENTS_MASK != (SEGMENT_A | SEGMENT_B | SEGMENT_C | SEGMENT_D | SEGMENT_E | SEGMENT_F | SEGMENT_G))
+#error "SegmentsUpdate() supone que los segmentos A a G ocupan los bits 0 a 6 de un puerto y el punto está en otro puerto"
+#endif
+
+#ifdef USE_CYCLE_PROBE
+//! Comienza a medir una sección de código, guardando el valor del contador de ciclos en la variable indicada
+#define PROBE_BEGIN(start) uint32_t start = DWT->CYCCNT
+//! Termina de medir una sección de código y registra sus ciclos
+#define PROBE_END(probe, start) ProbeRecord(probe, DWT->CYCCNT - (start))
+#else
+#define PROBE_BEGIN(start)
+#define PROBE_END(probe, start)
+#endif
+
+#ifndef BOARD_SCREEN_BLANKING_LOOPS
+#define BOARD_SCREEN_BLANKING_LOOPS 0 //!< Vueltas de espera con los displays apagados antes de cambiar los segmentos (0 sin espera)
+#endif
+
 /* === Private data type declarations ============================================================================== */
 
 /* === Private function declarations =============================================================================== */
@@ -74,6 +110,8 @@ static void DigitsTurnOff(void);
  *
  * @param segments Entero de 8 bits, en el que cada bit representa un segmento
  * del display según el numero que se quiera mostrar
+ *
+ * NOTA: Escribe una sola vez cada puerto (segmentos y punto), con las máscaras que se configuran al inicializar la placa
  */
 static void SegmentsUpdate(uint8_t segments);
 
@@ -81,9 +119,41 @@ static void SegmentsUpdate(uint8_t segments);
  * @brief Función que permite encender un display específico de la pantalla
  *
  * @param digit Digito específico que se desea habilitar
+ *
+ * NOTA: Un dígito que no existe en la pantalla del poncho no enciende ningún display
  */
 static void DigitTurnOn(uint8_t digit);
 
+/**
+ * @brief Función que programa el apagado del display encendido luego de una fracción del intervalo de su dígito
+ *
+ * @param duty Fracción del intervalo (sobre SCREEN_DUTY_FULL) en que el display permanece encendido
+ */
+static void DigitDim(uint16_t duty);
+
+/**
+ * @brief Función que atiende la interrupción de una de las teclas y avisa a la función registrada
+ *
+ * @param key Número de tecla (BOARD_KEY_*), que coincide con el canal de interrupción de pines
+ */
+static void KeyInterrupt(uint8_t key);
+
+#ifdef USE_CYCLE_PROBE
+/**
+ * @brief Función que habilita el contador de ciclos del núcleo y mide el costo de la propia medición
+ *
+ */
+static void ProbeInit(void);
+
+/**
+ * @brief Función que registra los ciclos de una ejecución de una sección de código
+ *
+ * @param probe Sección de código medida
+ * @param cycles Ciclos medidos, incluyendo el costo de la medición
+ */
+static void ProbeRecord(board_probe_t probe, uint32_t cycles);
+#endif
+
 /* === Private variable definitions ================================================================================ */
 
 //! Estructura constante que representa el driver de la pantalla con las funciones de callback
@@ -91,8 +161,48 @@ static const struct screen_driver_s screen_driver = {
     .DigitsTurnOff = DigitsTurnOff,
     .SegmentsUpdate = SegmentsUpdate,
     .DigitTurnOn = DigitTurnOn,
+    .DigitDim = DigitDim,
+};
+
+//! Habilitador de cada display, en el orden de los dígitos de la pantalla (el dígito 0 es el MSB, en DIGITO_4)
+static const uint32_t DIGIT_ENABLE[SCREEN_DIGITS] = {DIGIT_4_MASK, DIGIT_3_MASK, DIGIT_2_MASK, DIGIT_1_MASK};
+
+//! Puerto y bit GPIO de cada tecla, en el orden de los números BOARD_KEY_*
+static const struct {
+    uint8_t gpio; //!< Puerto GPIO de la tecla
+    uint8_t bit;  //!< Bit del puerto GPIO de la tecla
+} KEY_PINS[BOARD_KEYS] = {
+    [BOARD_KEY_F1] = {KEY_F1_GPIO, KEY_F1_BIT},
+    [BOARD_KEY_F2] = {KEY_F2_GPIO, KEY_F2_BIT},
+    [BOARD_KEY_F3] = {KEY_F3_GPIO, KEY_F3_BIT},
+    [BOARD_KEY_F4] = {KEY_F4_GPIO, KEY_F4_BIT},
+    [BOARD_KEY_ACCEPT] = {KEY_ACCEPT_GPIO, KEY_ACCEPT_BIT},
+    [BOARD_KEY_CANCEL] = {KEY_CANCEL_GPIO, KEY_CANCEL_BIT},
 };
 
+//! Función a la que se avisan los flancos de las teclas (NULL si no se habilitaron las interrupciones)
+static board_key_handler_t key_handler = NULL;
+
+//! Contexto que se le pasa a la función que recibe los flancos de las teclas
+static void* key_context = NULL;
+
+//! Función que se llama en cada interrupción del temporizador de la pantalla (NULL si no se inició)
+static board_timer_handler_t screen_timer_handler = NULL;
+
+//! Contexto que se le pasa a la función del temporizador de la pantalla
+static void* screen_timer_context = NULL;
+
+//! Cuentas del temporizador de la pantalla en el intervalo de un dígito
+static uint32_t screen_timer_ticks = 0;
+
+#ifdef USE_CYCLE_PROBE
+//! Ciclos medidos en cada sección de código (pueden leerse también desde el depurador)
+static board_cycles_t probe_cycles[BOARD_PROBE_COUNT];
+
+//! Ciclos que cuesta la propia medición, que se descuentan de cada sección
+static uint32_t probe_overhead = 0;
+#endif
+
 /* === Public variable definitions ================================================================================= */
 
 /* === Private function definitions ================================================================================ */
@@ -139,6 +249,9 @@ static void SegmentsInit(void) {
     Chip_GPIO_SetPinDIR(LPC_GPIO_PORT, SEGMENT_G_GPIO, SEGMENT_G_BIT, true);
 
     Chip_GPIO_ClearValue(LPC_GPIO_PORT, SEGMENTS_GPIO, SEGMENTS_MASK);
+
+    // Las escrituras enmascaradas del puerto solo modifican los bits de los segmentos
+    Chip_GPIO_SetPortMask(LPC_GPIO_PORT, SEGMENTS_GPIO, ~SEGMENTS_MASK);
 }
 
 static void DotsInit(void) {
@@ -146,28 +259,156 @@ static void DotsInit(void) {
     Chip_SCU_PinMuxSet(SEGMENT_P_PORT, SEGMENT_P_PIN, SCU_MODE_INBUFF_EN | SCU_MODE_INACT | SEGMENT_P_FUNC);
     Chip_GPIO_SetPinDIR(LPC_GPIO_PORT, SEGMENT_P_GPIO, SEGMENT_P_BIT, true);
     Chip_GPIO_SetPinState(LPC_GPIO_PORT, SEGMENT_P_GPIO, SEGMENT_P_BIT, false);
+
+    // Las escrituras enmascaradas del puerto solo modifican el bit del punto (las teclas se leen sin máscara)
+    Chip_GPIO_SetPortMask(LPC_GPIO_PORT, SEGMENT_P_GPIO, (uint32_t) ~(1U << SEGMENT_P_BIT));
 }
 
 static void DigitsTurnOff(void) {
     Chip_GPIO_ClearValue(LPC_GPIO_PORT, DIGITS_GPIO, DIGITS_MASK);
+
+#if BOARD_SCREEN_BLANKING_LOOPS > 0
+    // Espera a que se apaguen los transistores de los displays, para que los segmentos nuevos no se vean en el anterior
+    for (volatile uint32_t loops = 0; loops < BOARD_SCREEN_BLANKING_LOOPS; loops++) {
+    }
+#endif
 }
 
 static void SegmentsUpdate(uint8_t segments) {
-    Chip_GPIO_ClearValue(LPC_GPIO_PORT, SEGMENTS_GPIO, SEGMENTS_MASK);
-    Chip_GPIO_SetPinState(LPC_GPIO_PORT, SEGMENT_P_GPIO, SEGMENT_P_BIT, false);
+    PROBE_BEGIN(start);
 
-    Chip_GPIO_SetValue(LPC_GPIO_PORT, SEGMENTS_GPIO, (segments & SEGMENTS_MASK));
-    Chip_GPIO_SetPinState(LPC_GPIO_PORT, SEGMENT_P_GPIO, SEGMENT_P_BIT, (segments & SEGMENT_P));
+    // Una única escritura enmascarada por puerto cambia todos los segmentos y el punto, sin pasar por cero
+    Chip_GPIO_SetMaskedPortValue(LPC_GPIO_PORT, SEGMENTS_GPIO, segments);
+    Chip_GPIO_SetMaskedPortValue(LPC_GPIO_PORT, SEGMENT_P_GPIO, ((segments & SEGMENT_P) != 0) ? (1U << SEGMENT_P_BIT) : 0);
+
+    PROBE_END(BOARD_PROBE_SEGMENTS_UPDATE, start);
 }
 
 static void DigitTurnOn(uint8_t digit) {
-    Chip_GPIO_SetValue(LPC_GPIO_PORT, DIGITS_GPIO, ((1 << (3 - digit)) & DIGITS_MASK));
+    PROBE_BEGIN(start);
+
+    if (digit < SCREEN_DIGITS) {
+        Chip_GPIO_SetValue(LPC_GPIO_PORT, DIGITS_GPIO, DIGIT_ENABLE[digit]);
+    }
+
+    PROBE_END(BOARD_PROBE_DIGIT_TURN_ON, start);
+}
+
+static void DigitDim(uint16_t duty) {
+    uint32_t off;
+
+    // Solo se puede atenuar cuando el temporizador marca el intervalo de cada dígito
+    if (screen_timer_handler != NULL) {
+        // Con 12 bits de la fracción el producto entra en 32 bits para cualquier período de hasta 1 ms a 204 MHz
+        off = (screen_timer_ticks * (duty >> 4)) >> 12;
+
+        // Si el instante de apagado ya pasó mientras se atendía la interrupción, el display se apaga de inmediato
+        if (off <= Chip_TIMER_ReadCount(SCREEN_TIMER)) {
+            DigitsTurnOff();
+        } else {
+            Chip_TIMER_SetMatch(SCREEN_TIMER, SCREEN_DIM_MATCH, off);
+            Chip_TIMER_MatchEnableInt(SCREEN_TIMER, SCREEN_DIM_MATCH);
+        }
+    }
+}
+
+static void KeyInterrupt(uint8_t key) {
+    Chip_PININT_ClearIntStatus(LPC_GPIO_PIN_INT, PININTCH(key));
+
+    if (key_handler != NULL) {
+        key_handler(key_context);
+    }
 }
 
+#ifdef USE_CYCLE_PROBE
+static void ProbeInit(void) {
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    for (uint8_t probe = 0; probe < BOARD_PROBE_COUNT; probe++) {
+        probe_cycles[probe] = (board_cycles_t){.last = 0, .min = UINT32_MAX, .max = 0, .count = 0};
+    }
+
+    // Una sección vacía mide solo lo que cuesta leer el contador al comenzar y al terminar
+    PROBE_BEGIN(start);
+    probe_overhead = DWT->CYCCNT - start;
+}
+
+static void ProbeRecord(board_probe_t probe, uint32_t cycles) {
+    board_cycles_t* record = &probe_cycles[probe];
+
+    cycles = (cycles > probe_overhead) ? cycles - probe_overhead : 0;
+    record->last = cycles;
+    record->count++;
+    if (cycles < record->min) {
+        record->min = cycles;
+    }
+    if (cycles > record->max) {
+        record->max = cycles;
+    }
+}
+#endif
+
 /* === Public function definitions ================================================================================= */
 
+//! Rutina de servicio de la interrupción de la tecla "F1"
+void GPIO0_IRQHandler(void) {
+    KeyInterrupt(BOARD_KEY_F1);
+}
+
+//! Rutina de servicio de la interrupción de la tecla "F2"
+void GPIO1_IRQHandler(void) {
+    KeyInterrupt(BOARD_KEY_F2);
+}
+
+//! Rutina de servicio de la interrupción de la tecla "F3"
+void GPIO2_IRQHandler(void) {
+    KeyInterrupt(BOARD_KEY_F3);
+}
+
+//! Rutina de servicio de la interrupción de la tecla "F4"
+void GPIO3_IRQHandler(void) {
+    KeyInterrupt(BOARD_KEY_F4);
+}
+
+//! Rutina de servicio de la interrupción de la tecla "Aceptar"
+void GPIO4_IRQHandler(void) {
+    KeyInterrupt(BOARD_KEY_ACCEPT);
+}
+
+//! Rutina de servicio de la interrupción de la tecla "Cancelar"
+void GPIO5_IRQHandler(void) {
+    KeyInterrupt(BOARD_KEY_CANCEL);
+}
+
+//! Rutina de servicio de la interrupción del temporizador de la pantalla
+void TIMER0_IRQHandler(void) {
+    if (Chip_TIMER_MatchPending(SCREEN_TIMER, SCREEN_DIM_MATCH)) {
+        Chip_TIMER_ClearMatch(SCREEN_TIMER, SCREEN_DIM_MATCH);
+        Chip_TIMER_MatchDisableInt(SCREEN_TIMER, SCREEN_DIM_MATCH);
+        DigitsTurnOff();
+    }
+
+    if (Chip_TIMER_MatchPending(SCREEN_TIMER, SCREEN_TIMER_MATCH)) {
+        Chip_TIMER_ClearMatch(SCREEN_TIMER, SCREEN_TIMER_MATCH);
+
+        if (screen_timer_handler != NULL) {
+            PROBE_BEGIN(start);
+            screen_timer_handler(screen_timer_context);
+            PROBE_END(BOARD_PROBE_SCREEN_REFRESH, start);
+        }
+    }
+}
+
+#ifndef USE_STATIC_MEMORY
 board_t BoardCreate() {
-    struct board_s* self = malloc(sizeof(struct board_s));
+    return BoardCreateStatic(malloc(sizeof(board_storage_t)));
+}
+#endif
+
+board_t BoardCreateStatic(board_storage_t* storage) {
+    struct board_s* self = (storage != NULL) ? &storage->board : NULL;
 
     if (self != NULL) {
 
@@ -183,7 +424,7 @@ board_t BoardCreate() {
         Chip_GPIO_SetPinDIR(LPC_GPIO_PORT, LED_RGB_GREEN_GPIO, LED_RGB_GREEN_BIT, true);
 
         Chip_SCU_PinMuxSet(LED_RGB_RED_PORT, LED_RGB_RED_PIN, SCU_MODE_INBUFF_EN | SCU_MODE_INACT | LED_RGB_RED_FUNC);
-        self->led_alarm = DigitalOutputCreate(LED_RGB_RED_GPIO, LED_RGB_RED_BIT, true);
+        self->led_alarm = DigitalOutputCreateStatic(&storage->led_alarm, LED_RGB_RED_GPIO, LED_RGB_RED_BIT, true);
 
         /******************/
         Chip_SCU_PinMuxSet(LED_R_PORT, LED_R_PIN, SCU_MODE_INBUFF_EN | SCU_MODE_INACT | LED_R_FUNC);
@@ -212,31 +453,96 @@ board_t BoardCreate() {
 
         /******************/
         Chip_SCU_PinMuxSet(KEY_F1_PORT, KEY_F1_PIN, SCU_MODE_INBUFF_EN | SCU_MODE_PULLUP | KEY_F1_FUNC);
-        self->key_F1 = DigitalInputCreate(KEY_F1_GPIO, KEY_F1_BIT, false);
+        self->key_F1 = DigitalInputCreateStatic(&storage->keys[0], KEY_F1_GPIO, KEY_F1_BIT, false);
 
         Chip_SCU_PinMuxSet(KEY_F2_PORT, KEY_F2_PIN, SCU_MODE_INBUFF_EN | SCU_MODE_PULLUP | KEY_F2_FUNC);
-        self->key_F2 = DigitalInputCreate(KEY_F2_GPIO, KEY_F2_BIT, false);
+        self->key_F2 = DigitalInputCreateStatic(&storage->keys[1], KEY_F2_GPIO, KEY_F2_BIT, false);
 
         Chip_SCU_PinMuxSet(KEY_F3_PORT, KEY_F3_PIN, SCU_MODE_INBUFF_EN | SCU_MODE_PULLUP | KEY_F3_FUNC);
-        self->key_F3 = DigitalInputCreate(KEY_F3_GPIO, KEY_F3_BIT, false);
+        self->key_F3 = DigitalInputCreateStatic(&storage->keys[2], KEY_F3_GPIO, KEY_F3_BIT, false);
 
         Chip_SCU_PinMuxSet(KEY_F4_PORT, KEY_F4_PIN, SCU_MODE_INBUFF_EN | SCU_MODE_PULLUP | KEY_F4_FUNC);
-        self->key_F4 = DigitalInputCreate(KEY_F4_GPIO, KEY_F4_BIT, false);
+        self->key_F4 = DigitalInputCreateStatic(&storage->keys[3], KEY_F4_GPIO, KEY_F4_BIT, false);
 
         Chip_SCU_PinMuxSet(KEY_ACCEPT_PORT, KEY_ACCEPT_PIN, SCU_MODE_INBUFF_EN | SCU_MODE_PULLUP | KEY_ACCEPT_FUNC);
-        self->key_accept = DigitalInputCreate(KEY_ACCEPT_GPIO, KEY_ACCEPT_BIT, false);
+        self->key_accept = DigitalInputCreateStatic(&storage->keys[4], KEY_ACCEPT_GPIO, KEY_ACCEPT_BIT, false);
 
         Chip_SCU_PinMuxSet(KEY_CANCEL_PORT, KEY_CANCEL_PIN, SCU_MODE_INBUFF_EN | SCU_MODE_PULLUP | KEY_CANCEL_FUNC);
-        self->key_cancel = DigitalInputCreate(KEY_CANCEL_GPIO, KEY_CANCEL_BIT, false);
+        self->key_cancel = DigitalInputCreateStatic(&storage->keys[5], KEY_CANCEL_GPIO, KEY_CANCEL_BIT, false);
 
         /******************/
+#ifdef USE_CYCLE_PROBE
+        ProbeInit();
+#endif
         DigitsInit();
         SegmentsInit();
         DotsInit();
-        self->screen = ScreenCreate(4, &screen_driver);
+        self->screen = ScreenCreateStatic(&storage->screen, SCREEN_DIGITS, &screen_driver);
     }
 
     return self;
 }
 
+void BoardEnableKeyInterrupts(board_t board, board_key_handler_t handler, void* context) {
+    (void)board;
+    key_context = context;
+    key_handler = handler;
+
+    for (uint8_t key = 0; key < BOARD_KEYS; key++) {
+        Chip_SCU_GPIOIntPinSel(key, KEY_PINS[key].gpio, KEY_PINS[key].bit);
+        Chip_PININT_ClearIntStatus(LPC_GPIO_PIN_INT, PININTCH(key));
+        Chip_PININT_SetPinModeEdge(LPC_GPIO_PIN_INT, PININTCH(key));
+        Chip_PININT_EnableIntLow(LPC_GPIO_PIN_INT, PININTCH(key));
+        Chip_PININT_EnableIntHigh(LPC_GPIO_PIN_INT, PININTCH(key));
+
+        NVIC_ClearPendingIRQ(PIN_INT0_IRQn + key);
+        NVIC_SetPriority(PIN_INT0_IRQn + key, BOARD_KEYS_IRQ_PRIORITY);
+        NVIC_EnableIRQ(PIN_INT0_IRQn + key);
+    }
+}
+
+void BoardStartScreenTimer(board_t board, uint32_t frequency, board_timer_handler_t handler, void* context) {
+    (void)board;
+    screen_timer_context = context;
+    screen_timer_handler = handler;
+    screen_timer_ticks = Chip_Clock_GetRate(SCREEN_TIMER_CLOCK) / frequency;
+
+    Chip_TIMER_Init(SCREEN_TIMER);
+    Chip_TIMER_Reset(SCREEN_TIMER);
+    Chip_TIMER_SetMatch(SCREEN_TIMER, SCREEN_TIMER_MATCH, screen_timer_ticks - 1);
+    Chip_TIMER_ResetOnMatchEnable(SCREEN_TIMER, SCREEN_TIMER_MATCH);
+    Chip_TIMER_MatchEnableInt(SCREEN_TIMER, SCREEN_TIMER_MATCH);
+
+    NVIC_ClearPendingIRQ(SCREEN_TIMER_IRQ);
+    NVIC_SetPriority(SCREEN_TIMER_IRQ, BOARD_SCREEN_IRQ_PRIORITY);
+    NVIC_EnableIRQ(SCREEN_TIMER_IRQ);
+
+    Chip_TIMER_Enable(SCREEN_TIMER);
+}
+
+uint32_t BoardReadKeys(void) {
+    uint32_t port = Chip_GPIO_GetPortValue(LPC_GPIO_PORT, KEYS_GPIO);
+
+    // F1 a F4 ocupan bits consecutivos del puerto y se trasladan juntas a los bits BOARD_KEY_F1 a BOARD_KEY_F4
+    return ((port >> KEY_F1_BIT) & KEYS_F_MASK) | (((port >> KEY_ACCEPT_BIT) & 1U) << BOARD_KEY_ACCEPT) | (((port >> KEY_CANCEL_BIT) & 1U) << BOARD_KEY_CANCEL);
+}
+
+#ifdef USE_CYCLE_PROBE
+bool BoardGetCycles(board_probe_t probe, board_cycles_t* cycles) {
+    bool result = false;
+    uint32_t primask;
+
+    if ((probe < BOARD_PROBE_COUNT) && (cycles != NULL)) {
+        // Las interrupciones se enmascaran para que la copia no quede a medias si en medio se registra otra medición
+        primask = __get_PRIMASK();
+        __disable_irq();
+        *cycles = probe_cycles[probe];
+        __set_PRIMASK(primask);
+        result = true;
+    }
+
+    return result;
+}
+#endif
+
 /* === End of documentation ======================================================================================== */
\ No newline at end of file
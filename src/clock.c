@@ -26,6 +26,8 @@ SPDX-License-Identifier: MIT
 
 #include "FreeRTOS.h"
 #include "task.h"
+#include "timers.h"
+#include "semphr.h"
 #include "clock.h"
 #include <stddef.h>
 #include <string.h>
@@ -33,25 +35,81 @@ SPDX-License-Identifier: MIT
 
 /* === Macros definitions ========================================================================================== */
 
+#define SECONDS_PER_MINUTE    60U         //!< Cantidad de segundos que tiene un minuto
+#define SECONDS_PER_HOUR      3600U       //!< Cantidad de segundos que tiene una hora
+#define SECONDS_PER_DAY       86400U      //!< Cantidad de segundos que tiene un día
+#define CLOCK_INVALID_SECONDS 0xFFFFFFFFU //!< Valor que nunca corresponde a un segundo del día (indica alarma sin instante programado)
+
+#ifndef CLOCK_ALARM_CATCH_UP_SECONDS
+#define CLOCK_ALARM_CATCH_UP_SECONDS 3600U //!< Máximo salto hacia adelante al ajustar la hora que dispara una alarma salteada
+#endif
+
+#ifndef CLOCK_MEMORY_BARRIER
+#define CLOCK_MEMORY_BARRIER() __sync_synchronize() //!< Barrera que impide reordenar accesos a memoria (DMB en Cortex-M)
+#endif
+
+#ifndef CLOCK_TICKLESS_MAX_SLEEP_SECONDS
+#define CLOCK_TICKLESS_MAX_SLEEP_SECONDS 3600U //!< Tiempo máximo entre dos sincronizaciones del reloj en modo sin tick
+#endif
+
 /* === Private data type declarations ============================================================================== */
 
+/*! Estructura de datos que representa una de las alarmas del Reloj */
+struct clock_alarm_s {
+    uint32_t setted_seconds;           //!< Hora seteada para la alarma, expresada en segundos del día
+    uint32_t snoozed_seconds;          //!< Hora a la que debe sonar la alarma en caso de haber sido pospuesta (segundos del día)
+    uint32_t deadline;                 //!< Segundo del día en el que debe sonar la alarma (o su posposición), o CLOCK_INVALID_SECONDS
+    bool activated;                    //!< Indica si la alarma está activada
+    bool ringing_enabled;              //!< Indica si está habilitado el sonido de la alarma
+    bool snoozed;                      //!< Indica si la alarma fue pospuesta
+    bool ringing;                      //!< Indica si la alarma está sonando
+    clock_alarm_driver_t alarm_driver; //!< Driver con las funciones de callback para gestionar el sonido de esta alarma
+};
+
+//! Puntero a una de las alarmas del Reloj
+typedef struct clock_alarm_s* clock_alarm_t;
+
+/*! Copia publicada de la base de tiempo del Reloj, que leen las tareas que consultan la hora */
+struct clock_snapshot_s {
+    uint32_t seconds;                //!< Segundos del día de la hora actual
+    uint32_t epoch_tick;             //!< Valor de la base de tiempo en el que se sincronizó el reloj por última vez
+    uint16_t clock_tick;             //!< Cuenta de ticks dentro del segundo actual al momento de la sincronización
+    bool valid;                      //!< Indica que la hora seteada es válida
+    clock_tick_source_t tick_source; //!< Base de tiempo libre de la que se deriva la hora (NULL si se usa ClockTick)
+};
+
 /*! Estructura de datos que representa un Reloj */
 struct clock_s {
-    clock_time_t current_time;         //!< Contiene la hora, minutos y segundos actuales del reloj
-    bool valid_time;                   //!< Indica que la hora seteada es válida
-    uint16_t ticks_per_second;         //!< Indica cuantos ticks hay en un segundo
-    uint16_t current_clock_tick;       //!< Cuenta interna actual de los ticks
-    clock_time_t setted_alarm_time;    //!< Hora seteada para la alarma
-    bool activated_alarm;              //!< Indica si la alarma está activada
-    bool alarm_is_ringing;             //!< Indica si la alarma está sonando
-    bool ringig_is_enabled;            //!< Indica si está habilitado el sonido de la alarma
-    bool snoozed_alarm;                //!< Indica si la alarma fue pospuesta
-    uint16_t snooze_seconds;           //!< Representa la cantidad de segundos que se pospone la alarma
-    uint16_t seconds_count;            //!< Cuenta interma actual de los segundos
-    clock_time_t snoozed_alarm_time;   //!< Hora a la que debe sonar la alarma en caso de haber sido pospuesta
-    clock_alarm_driver_t alarm_driver; //!< Driver del reloj con las funciones de callback para gestionar la alarma
+    uint32_t current_seconds;                      //!< Hora actual del reloj, expresada en segundos transcurridos desde las 00:00:00
+    bool valid_time;                               //!< Indica que la hora seteada es válida
+    uint16_t ticks_per_second;                     //!< Indica cuantos ticks hay en un segundo
+    uint16_t current_clock_tick;                   //!< Cuenta interna actual de los ticks
+    uint16_t snooze_seconds;                       //!< Representa la cantidad de segundos que se pospone la alarma
+    struct clock_alarm_s alarms[CLOCK_MAX_ALARMS]; //!< Tabla de alarmas del reloj. La alarma 0 es la de las funciones sin número de alarma
+    uint8_t schedule[CLOCK_MAX_ALARMS];            //!< Índices de las alarmas pendientes, ordenados según cuál suena primero
+    uint8_t scheduled_alarms;                      //!< Cantidad de alarmas pendientes en "schedule"
+    clock_tick_source_t tick_source;               //!< Base de tiempo libre de la que se deriva la hora (NULL si se usa ClockTick)
+    uint32_t epoch_tick;                           //!< Valor de la base de tiempo en el que se sincronizó el reloj por última vez
+    TimerHandle_t tickless_timer;                  //!< Temporizador de un disparo que despierta al reloj en la próxima alarma
+    volatile uint32_t sequence;                    //!< Contador de secuencia de la hora publicada. Es impar mientras se escribe
+    volatile struct clock_snapshot_s published;    //!< Hora publicada para los lectores, protegida por "sequence"
+    clock_notify_t notify;                         //!< Función a la que se notifican los eventos del reloj (NULL si no hay)
+    void* notify_context;                          //!< Contexto que se le pasa a la función de notificación
+    uint32_t notify_events;                        //!< Máscara de los eventos que se desean notificar
+    uint32_t pending_events;                       //!< Eventos ocurridos que todavía no se notificaron
+    SemaphoreHandle_t lock;                        //!< Mutex que serializa a las tareas que modifican el reloj
+#ifdef USE_STATIC_MEMORY
+    StaticTimer_t tickless_timer_buffer; //!< Memoria del temporizador del modo sin tick
+    StaticSemaphore_t lock_buffer;       //!< Memoria del mutex del reloj
+#endif
 };
 
+//! Falla al compilar si clock_storage_t no alcanza para alojar los datos internos del reloj
+typedef char clock_storage_size_check_t[(sizeof(clock_storage_t) >= sizeof(struct clock_s)) ? 1 : -1];
+
+//! Falla al compilar si clock_storage_t reserva más memoria que la del reloj y su relleno de alineación
+typedef char clock_storage_slack_check_t[(sizeof(clock_storage_t) - sizeof(struct clock_s) <= 2 * sizeof(void*)) ? 1 : -1];
+
 /* === Private function declarations =============================================================================== */
 
 /**
@@ -64,39 +122,290 @@ struct clock_s {
 static bool CheckTimeIsValid(const clock_time_t* time);
 
 /**
- * @brief Función de Tick que solo incrementa la hora en 1 segundo cada vez que es llamada
+ * @brief Función interna que convierte una hora en formato BCD a segundos transcurridos desde las 00:00:00
+ *
+ * @param time Puntero a la estructura con la hora (válida) que se desea convertir
+ * @return uint32_t Cantidad de segundos del día que representa la hora ingresada
+ */
+static uint32_t TimeToSeconds(const clock_time_t* time);
+
+/**
+ * @brief Función interna que convierte una cantidad de segundos del día a una hora en formato BCD
+ *
+ * @param seconds Cantidad de segundos transcurridos desde las 00:00:00 (menor a SECONDS_PER_DAY)
+ * @param time Puntero a la estructura donde se guardará la hora en formato BCD
+ */
+static void SecondsToTime(uint32_t seconds, clock_time_t* time);
+
+/**
+ * @brief Función interna que suma (o resta) una cantidad de segundos a un segundo del día, en tiempo constante
+ *
+ * @param seconds Segundos del día a los que se desea sumar el desplazamiento
+ * @param delta Cantidad de segundos que se desean sumar (negativo para restar). Puede ser mayor a un día
+ * @return uint32_t Segundos del día resultantes, módulo SECONDS_PER_DAY
+ */
+static uint32_t AddSeconds(uint32_t seconds, int32_t delta);
+
+/**
+ * @brief Función interna que devuelve el segundo del día siguiente al indicado, pasando de 23:59:59 a 00:00:00
+ *
+ * @param seconds Segundos del día que se desean incrementar
+ * @return uint32_t Segundos del día incrementados en 1 unidad
+ */
+static uint32_t NextSecond(uint32_t seconds);
+
+/**
+ * @brief Función interna que calcula la hora actual, incluyendo los ticks de la base de tiempo no sincronizados
+ *
+ * @param clock Puntero a la estructura con los datos del Reloj
+ * @param clock_tick Puntero donde se guardará la cuenta de ticks dentro del segundo actual (puede ser NULL)
+ * @return uint32_t Segundos del día que corresponden a la hora actual
+ */
+static uint32_t GetCurrentSeconds(clock_t clock, uint16_t* clock_tick);
+
+/**
+ * @brief Función interna que calcula los segundos del día a partir de una copia de la base de tiempo
+ *
+ * @param snapshot Puntero a la copia de la base de tiempo
+ * @param ticks_per_second Cantidad de ticks que hay en un segundo
+ * @param clock_tick Puntero donde se guardará la cuenta de ticks dentro del segundo actual (puede ser NULL)
+ * @return uint32_t Segundos del día que corresponden a la hora actual
+ */
+static uint32_t SnapshotSeconds(const struct clock_snapshot_s* snapshot, uint16_t ticks_per_second, uint16_t* clock_tick);
+
+/**
+ * @brief Función interna que publica la hora actual para los lectores, protegida por el contador de secuencia
+ *
+ * @param clock Puntero a la estructura con los datos del Reloj
+ *
+ * NOTA: Se llama al final de cada modificación de la base de tiempo. Solo el escritor entra en sección crítica,
+ * y lo hace únicamente mientras copia unos pocos campos
+ */
+static void PublishTime(clock_t clock);
+
+/**
+ * @brief Función interna que obtiene una copia consistente de la hora publicada, sin bloquear al escritor
+ *
+ * @param clock Puntero a la estructura con los datos del Reloj
+ * @param snapshot Puntero donde se guardará la copia de la hora publicada
+ */
+static void ReadPublishedTime(clock_t clock, struct clock_snapshot_s* snapshot);
+
+/**
+ * @brief Función interna que toma el acceso exclusivo al reloj, esperando a que lo libere otra tarea que lo modifica
+ *
+ * @param clock Puntero a la estructura con los datos del Reloj
+ *
+ * NOTA: El mutex es recursivo, por lo que una función pública puede llamar a otra que también lo toma
+ */
+static void ClockLock(clock_t clock);
+
+/**
+ * @brief Función interna que libera el acceso exclusivo al reloj
+ *
+ * @param clock Puntero a la estructura con los datos del Reloj
+ */
+static void ClockUnlock(clock_t clock);
+
+/**
+ * @brief Función interna que toma el acceso exclusivo al reloj y lo sincroniza con su base de tiempo, antes de una
+ * modificación
+ *
+ * @param clock Puntero a la estructura con los datos del Reloj
+ *
+ * NOTA: Toda la modificación, desde la sincronización hasta la publicación de la hora y la agenda reconstruida,
+ * queda dentro del mismo acceso exclusivo. Así otra tarea que modifica el reloj (por ejemplo el temporizador del modo
+ * sin tick) no puede intercalarse y aplicar dos veces los mismos ticks ni mezclar su agenda con la de esta operación
+ */
+static void ClockBeginUpdate(clock_t clock);
+
+/**
+ * @brief Función interna que termina una modificación: publica la hora, reconstruye la agenda, entrega los eventos
+ * y libera el acceso exclusivo al reloj
+ *
+ * @param clock Puntero a la estructura con los datos del Reloj
+ */
+static void ClockEndUpdate(clock_t clock);
+
+/**
+ * @brief Función interna que incorpora al reloj los ticks transcurridos en la base de tiempo desde la última
+ * sincronización
+ *
+ * @param clock Puntero a la estructura con los datos del Reloj, con el acceso exclusivo tomado
+ *
+ * NOTA: La base de tiempo se lee una sola vez por modificación. Si otra sincronización ya incorporó ticks posteriores
+ * a los leídos, no queda nada por agregar y los ticks no se vuelven a aplicar
+ */
+static void SyncTicks(clock_t clock);
+
+/**
+ * @brief Función interna que avanza el reloj una cantidad de ticks, haciendo sonar en orden las alarmas que
+ * correspondan al intervalo salteado
+ *
+ * @param clock Puntero a la estructura con los datos del Reloj
+ * @param ticks Cantidad de ticks que se desea avanzar
+ *
+ * NOTA: El tiempo de ejecución no depende de la cantidad de ticks, sino de la cantidad de alarmas que suenan
+ */
+static void AdvanceTicks(clock_t clock, uint32_t ticks);
+
+/**
+ * @brief Función interna que se ejecuta cada vez que se cumple un segundo completo
+ *
+ * @param clock Puntero a la estructura con los datos del Reloj
+ */
+static void SecondElapsed(clock_t clock);
+
+/**
+ * @brief Función interna que hace sonar todas las alarmas agendadas para el segundo actual y las vuelve a agendar
+ *
+ * @param clock Puntero a la estructura con los datos del Reloj
+ */
+static void FireDueAlarms(clock_t clock);
+
+/**
+ * @brief Función interna que devuelve una de las alarmas del reloj
+ *
+ * @param clock Puntero a la estructura con los datos del Reloj
+ * @param alarm Número de alarma (entre 0 y CLOCK_MAX_ALARMS - 1)
+ * @return clock_alarm_t Puntero a la alarma, o NULL si el reloj o el número de alarma no son válidos
+ */
+static clock_alarm_t GetAlarm(clock_t clock, uint8_t alarm);
+
+/**
+ * @brief Función interna que recalcula el próximo instante en el que debe sonar una alarma
+ *
+ * @param alarm Puntero a la alarma
+ */
+static void UpdateAlarmDeadline(clock_alarm_t alarm);
+
+/**
+ * @brief Función interna que calcula cuántos segundos faltan para que suene una alarma pendiente
+ *
+ * @param alarm Puntero a la alarma, con un instante programado
+ * @param seconds Segundos del día desde los que se mide la distancia
+ * @return uint32_t Segundos que faltan, entre 1 y SECONDS_PER_DAY
+ */
+static uint32_t AlarmDistance(clock_alarm_t alarm, uint32_t seconds);
+
+/**
+ * @brief Función interna que agrega una alarma a la agenda, en la posición que le corresponde según cuándo suena
+ *
+ * @param clock Puntero a la estructura con los datos del Reloj
+ * @param alarm Número de alarma. Si no tiene un instante programado, no se agrega
+ */
+static void ScheduleInsert(clock_t clock, uint8_t alarm);
+
+/**
+ * @brief Función interna que quita de la agenda a la alarma que suena primero
+ *
+ * @param clock Puntero a la estructura con los datos del Reloj, con al menos una alarma en la agenda
+ * @return uint8_t Número de la alarma que se quitó
+ */
+static uint8_t ScheduleRemoveHead(clock_t clock);
+
+/**
+ * @brief Función interna que hace sonar una alarma al alcanzar su instante programado
+ *
+ * @param clock Puntero a la estructura con los datos del Reloj
+ * @param alarm Puntero a la alarma
+ */
+static void AlarmFired(clock_t clock, clock_alarm_t alarm);
+
+/**
+ * @brief Función interna que entrega a la aplicación los eventos pendientes que tiene suscriptos
+ *
+ * @param clock Puntero a la estructura con los datos del Reloj
+ *
+ * NOTA: Se llama al final de cada operación que avanza el reloj, una vez publicada la nueva hora, de manera que todos
+ * los eventos de la operación se entregan en una sola notificación
+ */
+static void NotifyEvents(clock_t clock);
+
+/**
+ * @brief Función interna que calcula cuántos ticks faltan para la primera alarma de la agenda
+ *
+ * @param clock Puntero a la estructura con los datos del Reloj
+ * @param seconds Segundos del día desde los que se mide la distancia
+ * @param clock_tick Cuenta de ticks dentro del segundo indicado
+ * @return uint32_t Cantidad de ticks hasta la próxima alarma, o CLOCK_NO_ALARM_PENDING si no hay ninguna pendiente
+ */
+static uint32_t TicksToNextAlarm(clock_t clock, uint32_t seconds, uint16_t clock_tick);
+
+/**
+ * @brief Función interna que calcula cuántos ticks puede dormir el reloj en modo sin tick
+ *
+ * @param clock Puntero a la estructura con los datos del Reloj, recién sincronizado
+ * @return uint32_t Ticks hasta la próxima alarma o el próximo cambio de segundo o minuto que se deba notificar,
+ * limitados a CLOCK_TICKLESS_MAX_SLEEP_SECONDS
+ */
+static uint32_t TicksToNextWakeUp(clock_t clock);
+
+/**
+ * @brief Función interna que permite saber si un ajuste de la hora saltó por encima del instante de una alarma
+ *
+ * @param clock Puntero a la estructura con los datos del Reloj, con la hora ya ajustada
+ * @param alarm Puntero a la alarma
+ * @param previous_seconds Segundos del día que tenía el reloj antes del ajuste
+ * @return true Si fue un salto hacia adelante de hasta CLOCK_ALARM_CATCH_UP_SECONDS que pasó por la alarma
+ * @return false En caso contrario
+ */
+static bool AlarmWasSkipped(clock_t clock, clock_alarm_t alarm, uint32_t previous_seconds);
+
+/**
+ * @brief Función interna que se llama cada vez que cambia la hora, una alarma o su estado, para reordenar la agenda
+ * de alarmas y reprogramar el despertar del reloj en modo sin tick
  *
  * @param clock Puntero a la estructura con los datos del Reloj
  */
-static void ClockTickIncrement(clock_time_t* current_time);
+static void AlarmScheduleChanged(clock_t clock);
+
+/**
+ * @brief Base de tiempo del modo sin tick, que corresponde a la cuenta de ticks de FreeRTOS
+ *
+ * @return uint32_t Cuenta actual de ticks de FreeRTOS
+ */
+static uint32_t ClockRtosTickSource(void);
 
 /**
- * @brief Función interna que incrementa los minutos en 1 unidad
+ * @brief Función de callback del temporizador del modo sin tick, que sincroniza el reloj y lo reprograma
+ *
+ * @param timer Temporizador que expiró. Su identificador es el puntero al reloj
  *
- * @param time Puntero a la estructura con los datos de la hora cuyos minutos se desean incrementar
+ * NOTA: Se ejecuta en la tarea de los temporizadores, que no debe bloquearse. Si otra tarea está modificando el reloj,
+ * no la espera: vuelve a intentarlo en el tick siguiente, aunque esa tarea igualmente reprograma el temporizador al
+ * terminar
  */
-static void IncrementMinutes(clock_time_t* time);
+static void ClockTicklessCallback(TimerHandle_t timer);
 
 /**
- * @brief Función interna que decrementa los minutos en 1 unidad
+ * @brief Función interna que inicializa los datos de un reloj recién creado
  *
- * @param time Puntero a la estructura con los datos de la hora cuyos minutos se desean decrementar
+ * @param self Puntero a la memoria del reloj (puede ser NULL si no se pudo reservar)
+ * @param ticks_per_second Cantidad de ticks que hay en un segundo
+ * @param snooze_seconds Cantidad de segundos que se pospone la alarma
+ * @param driver Driver con las funciones para encender y apagar la alarma
+ * @return clock_t El mismo puntero recibido
  */
-static void DecrementMinutes(clock_time_t* time);
+static clock_t ClockInit(clock_t self, uint16_t ticks_per_second, uint16_t snooze_seconds, clock_alarm_driver_t driver);
 
 /**
- * @brief Función interna que incrementa las horas en 1 unidad
+ * @brief Función interna que suma (o resta) una cantidad de minutos, sin modificar las horas
  *
- * @param time Puntero a la estructura con los datos de la hora cuyas horas se desean incrementar
+ * @param seconds Segundos del día cuyos minutos se desean modificar
+ * @param minutes Cantidad de minutos a sumar (negativo para restar). Al pasar de 59 se continúa desde 00 y viceversa
+ * @return uint32_t Segundos del día con los minutos modificados
  */
-static void IncrementHours(clock_time_t* time);
+static uint32_t AddMinutes(uint32_t seconds, int32_t minutes);
 
 /**
- * @brief Función interna que decrementa las horas en 1 unidad
+ * @brief Función interna que suma (o resta) una cantidad de horas, sin modificar los minutos ni los segundos
  *
- * @param time Puntero a la estructura con los datos de la hora cuyas horas se desean decrementar
+ * @param seconds Segundos del día cuyas horas se desean modificar
+ * @param hours Cantidad de horas a sumar (negativo para restar). Al pasar de 23 se continúa desde 00 y viceversa
+ * @return uint32_t Segundos del día con las horas modificadas
  */
-static void DecrementHours(clock_time_t* time);
+static uint32_t AddHours(uint32_t seconds, int32_t hours);
 
 /* === Private variable definitions ================================================================================ */
 
@@ -108,6 +417,13 @@ static bool CheckTimeIsValid(const clock_time_t* time) {
     bool result = true;
     int hours, minutes, seconds;
 
+    // Control de que cada dígito sea un valor BCD válido
+    for (int i = 0; i < (int)sizeof(clock_time_t); i++) {
+        if (time->bcd[i] > 9) {
+            result = false;
+        }
+    }
+
     // Control de que la hora esté entre 00 y 23
     hours = time->time.hours[0] * 10 + time->time.hours[1];
     if (hours < 0 || hours > 23) {
@@ -129,136 +445,478 @@ static bool CheckTimeIsValid(const clock_time_t* time) {
     return result;
 }
 
-static void ClockTickIncrement(clock_time_t* current_time) {
-    // Incremento de segundos
-    if (current_time->time.seconds[1] < 9) {
-        current_time->time.seconds[1]++;
-    } else {
-        current_time->time.seconds[1] = 0;
-        if (current_time->time.seconds[0] < 5) {
-            current_time->time.seconds[0]++;
-        } else {
-            current_time->time.seconds[0] = 0;
-
-            // Incremento de minutos
-            if (current_time->time.minutes[1] < 9) {
-                current_time->time.minutes[1]++;
-            } else {
-                current_time->time.minutes[1] = 0;
-                if (current_time->time.minutes[0] < 5) {
-                    current_time->time.minutes[0]++;
-                } else {
-                    current_time->time.minutes[0] = 0;
-
-                    // Incremento de horas
-                    if (current_time->time.hours[1] < 9) {
-                        current_time->time.hours[1]++;
-                    } else {
-                        current_time->time.hours[1] = 0;
-                        current_time->time.hours[0]++;
-                    }
-
-                    if (current_time->time.hours[0] == 2 && current_time->time.hours[1] == 4) {
-                        // Pasó de 23:59:59 a 00:00:00
-                        memset(current_time, 0, sizeof(clock_time_t));
-                    }
-                }
-            }
+static uint32_t TimeToSeconds(const clock_time_t* time) {
+    uint32_t hours = time->time.hours[0] * 10U + time->time.hours[1];
+    uint32_t minutes = time->time.minutes[0] * 10U + time->time.minutes[1];
+    uint32_t seconds = time->time.seconds[0] * 10U + time->time.seconds[1];
+
+    return hours * SECONDS_PER_HOUR + minutes * SECONDS_PER_MINUTE + seconds;
+}
+
+static void SecondsToTime(uint32_t seconds, clock_time_t* time) {
+    uint32_t hours = seconds / SECONDS_PER_HOUR;
+    uint32_t minutes = (seconds / SECONDS_PER_MINUTE) % 60U;
+
+    seconds = seconds % SECONDS_PER_MINUTE;
+
+    time->time.hours[0] = hours / 10U;
+    time->time.hours[1] = hours % 10U;
+    time->time.minutes[0] = minutes / 10U;
+    time->time.minutes[1] = minutes % 10U;
+    time->time.seconds[0] = seconds / 10U;
+    time->time.seconds[1] = seconds % 10U;
+}
+
+static uint32_t AddSeconds(uint32_t seconds, int32_t delta) {
+    // El resto queda en (-SECONDS_PER_DAY, SECONDS_PER_DAY), por lo que al sumarle un día siempre es positivo
+    int32_t offset = (delta % (int32_t)SECONDS_PER_DAY) + (int32_t)SECONDS_PER_DAY;
+
+    return (seconds + (uint32_t)offset) % SECONDS_PER_DAY;
+}
+
+static uint32_t NextSecond(uint32_t seconds) {
+    seconds++;
+    if (seconds == SECONDS_PER_DAY) {
+        // Pasó de 23:59:59 a 00:00:00
+        seconds = 0;
+    }
+
+    return seconds;
+}
+
+static uint32_t AddMinutes(uint32_t seconds, int32_t minutes) {
+    uint32_t minute = (seconds / SECONDS_PER_MINUTE) % 60U;
+    // El resto queda en (-60, 60), por lo que al sumarle una hora siempre es positivo
+    uint32_t offset = (uint32_t)((minutes % 60) + 60);
+
+    return seconds - minute * SECONDS_PER_MINUTE + ((minute + offset) % 60U) * SECONDS_PER_MINUTE;
+}
+
+static uint32_t AddHours(uint32_t seconds, int32_t hours) {
+    return AddSeconds(seconds, (hours % 24) * (int32_t)SECONDS_PER_HOUR);
+}
+
+static uint32_t GetCurrentSeconds(clock_t self, uint16_t* clock_tick) {
+    struct clock_snapshot_s snapshot = {
+        .seconds = self->current_seconds,
+        .epoch_tick = self->epoch_tick,
+        .clock_tick = self->current_clock_tick,
+        .valid = self->valid_time,
+        .tick_source = self->tick_source,
+    };
+
+    return SnapshotSeconds(&snapshot, self->ticks_per_second, clock_tick);
+}
+
+static uint32_t SnapshotSeconds(const struct clock_snapshot_s* snapshot, uint16_t ticks_per_second, uint16_t* clock_tick) {
+    uint32_t seconds = snapshot->seconds;
+    uint32_t ticks = snapshot->clock_tick;
+
+    if (snapshot->tick_source != NULL) {
+        ticks = ticks + (snapshot->tick_source() - snapshot->epoch_tick);
+        seconds = (seconds + (ticks / ticks_per_second) % SECONDS_PER_DAY) % SECONDS_PER_DAY;
+        ticks = ticks % ticks_per_second;
+    }
+
+    if (clock_tick != NULL) {
+        *clock_tick = (uint16_t)ticks;
+    }
+
+    return seconds;
+}
+
+static void PublishTime(clock_t self) {
+    taskENTER_CRITICAL();
+
+    self->sequence++;
+    CLOCK_MEMORY_BARRIER();
+
+    self->published.seconds = self->current_seconds;
+    self->published.epoch_tick = self->epoch_tick;
+    self->published.clock_tick = self->current_clock_tick;
+    self->published.valid = self->valid_time;
+    self->published.tick_source = self->tick_source;
+
+    CLOCK_MEMORY_BARRIER();
+    self->sequence++;
+
+    taskEXIT_CRITICAL();
+}
+
+static void ReadPublishedTime(clock_t self, struct clock_snapshot_s* snapshot) {
+    uint32_t sequence;
+
+    // Si el escritor modificó la hora mientras se copiaba (o la estaba modificando), se vuelve a copiar
+    do {
+        sequence = self->sequence;
+        CLOCK_MEMORY_BARRIER();
+
+        snapshot->seconds = self->published.seconds;
+        snapshot->epoch_tick = self->published.epoch_tick;
+        snapshot->clock_tick = self->published.clock_tick;
+        snapshot->valid = self->published.valid;
+        snapshot->tick_source = self->published.tick_source;
+
+        CLOCK_MEMORY_BARRIER();
+    } while (((sequence & 1U) != 0) || (sequence != self->sequence));
+}
+
+static void ClockLock(clock_t self) {
+    if (self->lock != NULL) {
+        xSemaphoreTakeRecursive(self->lock, portMAX_DELAY);
+    }
+}
+
+static void ClockUnlock(clock_t self) {
+    if (self->lock != NULL) {
+        xSemaphoreGiveRecursive(self->lock);
+    }
+}
+
+static void ClockBeginUpdate(clock_t self) {
+    ClockLock(self);
+    SyncTicks(self);
+}
+
+static void ClockEndUpdate(clock_t self) {
+    PublishTime(self);
+    AlarmScheduleChanged(self);
+    NotifyEvents(self);
+    ClockUnlock(self);
+}
+
+static void SyncTicks(clock_t self) {
+    uint32_t now;
+    uint32_t ticks;
+
+    if (self->tick_source != NULL) {
+        now = self->tick_source();
+        ticks = now - self->epoch_tick;
+
+        // La nueva referencia se fija antes de avanzar, para que nada que se ejecute durante el avance cuente otra vez
+        // los mismos ticks. Una diferencia negativa indica que otra sincronización ya fue más allá de la lectura
+        if ((int32_t)ticks > 0) {
+            self->epoch_tick = now;
+            AdvanceTicks(self, ticks);
         }
     }
 }
 
-static void IncrementMinutes(clock_time_t* current_time) {
-    if (current_time->time.minutes[1] < 9) {
-        current_time->time.minutes[1]++;
-    } else {
-        current_time->time.minutes[1] = 0;
-        if (current_time->time.minutes[0] < 5) {
-            current_time->time.minutes[0]++;
-        } else {
-            current_time->time.minutes[0] = 0;
+static void AdvanceTicks(clock_t self, uint32_t ticks) {
+    uint32_t seconds = ticks / self->ticks_per_second;
+    uint32_t clock_tick = self->current_clock_tick + ticks % self->ticks_per_second;
+    uint32_t distance;
+
+    if (clock_tick >= self->ticks_per_second) {
+        clock_tick = clock_tick - self->ticks_per_second;
+        seconds++;
+    }
+    self->current_clock_tick = (uint16_t)clock_tick;
+
+    // Luego de un día completo todas las alarmas ya sonaron y quedaron programadas para su hora, por lo que los días
+    // intermedios de un salto mayor a dos días solo las harían sonar otra vez sin cambiar el estado del reloj
+    if (seconds >= 2U * SECONDS_PER_DAY) {
+        seconds = SECONDS_PER_DAY + seconds % SECONDS_PER_DAY;
+    }
+
+    // Se salta directamente de una alarma a la siguiente, sin recorrer los segundos intermedios
+    while (self->scheduled_alarms > 0) {
+        distance = AlarmDistance(&(self->alarms[self->schedule[0]]), self->current_seconds);
+        if (distance > seconds) {
+            break;
         }
+
+        self->pending_events |= CLOCK_EVENT_SECOND;
+        if ((self->current_seconds % SECONDS_PER_MINUTE) + distance >= SECONDS_PER_MINUTE) {
+            self->pending_events |= CLOCK_EVENT_MINUTE;
+        }
+        self->current_seconds = (self->current_seconds + distance) % SECONDS_PER_DAY;
+        seconds = seconds - distance;
+        FireDueAlarms(self);
+    }
+
+    if (seconds > 0) {
+        self->pending_events |= CLOCK_EVENT_SECOND;
+        if ((self->current_seconds % SECONDS_PER_MINUTE) + seconds >= SECONDS_PER_MINUTE) {
+            self->pending_events |= CLOCK_EVENT_MINUTE;
+        }
+    }
+    self->current_seconds = (self->current_seconds + seconds) % SECONDS_PER_DAY;
+}
+
+static void SecondElapsed(clock_t self) {
+    self->current_seconds = NextSecond(self->current_seconds);
+
+    self->pending_events |= CLOCK_EVENT_SECOND;
+    if (self->current_seconds % SECONDS_PER_MINUTE == 0) {
+        self->pending_events |= CLOCK_EVENT_MINUTE;
+    }
+    FireDueAlarms(self);
+}
+
+static void FireDueAlarms(clock_t self) {
+    uint8_t fired[CLOCK_MAX_ALARMS];
+    uint8_t count = 0;
+
+    // Las alarmas que suenan en este segundo están todas al principio de la agenda, por lo que solo se mira la cabecera
+    while ((self->scheduled_alarms > 0) && (self->alarms[self->schedule[0]].deadline == self->current_seconds)) {
+        fired[count] = ScheduleRemoveHead(self);
+        count++;
+    }
+
+    // Se vuelven a agendar recién cuando no queda ninguna pendiente para este segundo, para no alterar el orden
+    for (uint8_t index = 0; index < count; index++) {
+        AlarmFired(self, &(self->alarms[fired[index]]));
+        ScheduleInsert(self, fired[index]);
+    }
+}
+
+static clock_alarm_t GetAlarm(clock_t self, uint8_t alarm) {
+    clock_alarm_t result = NULL;
+
+    if ((self != NULL) && (alarm < CLOCK_MAX_ALARMS)) {
+        result = &(self->alarms[alarm]);
     }
+
+    return result;
 }
 
-static void DecrementMinutes(clock_time_t* current_time) {
-    if (current_time->time.minutes[1] > 0) {
-        current_time->time.minutes[1]--;
+static void UpdateAlarmDeadline(clock_alarm_t alarm) {
+    if (alarm->ringing_enabled == false) {
+        alarm->deadline = CLOCK_INVALID_SECONDS;
+    } else if (alarm->snoozed) {
+        alarm->deadline = alarm->snoozed_seconds;
+    } else if (alarm->activated) {
+        alarm->deadline = alarm->setted_seconds;
     } else {
-        current_time->time.minutes[1] = 9;
-        if (current_time->time.minutes[0] > 0) {
-            current_time->time.minutes[0]--;
-        } else {
-            current_time->time.minutes[0] = 5;
-        }
+        alarm->deadline = CLOCK_INVALID_SECONDS;
+    }
+}
+
+static uint32_t AlarmDistance(clock_alarm_t alarm, uint32_t seconds) {
+    uint32_t distance = (alarm->deadline + SECONDS_PER_DAY - seconds) % SECONDS_PER_DAY;
+
+    // Si la alarma coincide con el segundo indicado, ya fue evaluada y la próxima es al día siguiente
+    if (distance == 0) {
+        distance = SECONDS_PER_DAY;
     }
+
+    return distance;
 }
 
-static void IncrementHours(clock_time_t* current_time) {
-    if (current_time->time.hours[0] < 2) {
-        if (current_time->time.hours[1] < 9) {
-            current_time->time.hours[1]++;
-        } else {
-            current_time->time.hours[1] = 0;
-            current_time->time.hours[0]++;
+static void ScheduleInsert(clock_t self, uint8_t alarm) {
+    uint32_t distance;
+    uint8_t position;
+
+    if (self->alarms[alarm].deadline != CLOCK_INVALID_SECONDS) {
+        distance = AlarmDistance(&(self->alarms[alarm]), self->current_seconds);
+        position = self->scheduled_alarms;
+
+        // A igual distancia, la alarma queda detrás de las que ya estaban agendadas
+        while ((position > 0) && (AlarmDistance(&(self->alarms[self->schedule[position - 1]]), self->current_seconds) > distance)) {
+            self->schedule[position] = self->schedule[position - 1];
+            position--;
         }
-    } else if (current_time->time.hours[1] < 3) {
-        current_time->time.hours[1]++;
+
+        self->schedule[position] = alarm;
+        self->scheduled_alarms++;
+    }
+}
+
+static uint8_t ScheduleRemoveHead(clock_t self) {
+    uint8_t alarm = self->schedule[0];
+
+    self->scheduled_alarms--;
+    memmove(&(self->schedule[0]), &(self->schedule[1]), self->scheduled_alarms);
+
+    return alarm;
+}
+
+static void AlarmFired(clock_t self, clock_alarm_t alarm) {
+    if (alarm->snoozed) {
+        self->pending_events |= CLOCK_EVENT_SNOOZE_EXPIRED;
     } else {
-        current_time->time.hours[1] = 0;
-        current_time->time.hours[0] = 0;
+        self->pending_events |= CLOCK_EVENT_ALARM_FIRED;
+    }
+
+    alarm->snoozed = false;
+    alarm->ringing = true;
+    alarm->alarm_driver->ClockAlarmTurnOn();
+
+    // Luego de sonar, la alarma queda programada para la misma hora del día siguiente
+    UpdateAlarmDeadline(alarm);
+}
+
+static bool AlarmWasSkipped(clock_t self, clock_alarm_t alarm, uint32_t previous_seconds) {
+    bool result = false;
+    uint32_t jump;
+    uint32_t distance;
+
+    if (alarm->deadline != CLOCK_INVALID_SECONDS) {
+        jump = (self->current_seconds + SECONDS_PER_DAY - previous_seconds) % SECONDS_PER_DAY;
+        distance = (alarm->deadline + SECONDS_PER_DAY - previous_seconds) % SECONDS_PER_DAY;
+
+        if ((jump <= CLOCK_ALARM_CATCH_UP_SECONDS) && (distance > 0) && (distance <= jump)) {
+            result = true;
+        }
+    }
+
+    return result;
+}
+
+static void AlarmScheduleChanged(clock_t self) {
+    uint32_t ticks;
+
+    // La agenda se reconstruye completa: es una operación poco frecuente y la tabla de alarmas es chica
+    self->scheduled_alarms = 0;
+    for (uint8_t alarm = 0; alarm < CLOCK_MAX_ALARMS; alarm++) {
+        UpdateAlarmDeadline(&(self->alarms[alarm]));
+        ScheduleInsert(self, alarm);
+    }
+
+    if (self->tickless_timer != NULL) {
+        ticks = TicksToNextWakeUp(self);
+
+        // Cambiar el período de un temporizador también lo vuelve a iniciar, contando desde este instante
+        xTimerChangePeriod(self->tickless_timer, (TickType_t)ticks, 0);
+    }
+}
+
+static void NotifyEvents(clock_t self) {
+    uint32_t events = self->pending_events & self->notify_events;
+
+    self->pending_events = 0;
+    if ((self->notify != NULL) && (events != 0)) {
+        self->notify(self->notify_context, events);
     }
 }
 
-static void DecrementHours(clock_time_t* current_time) {
-    if (current_time->time.hours[0] > 0) {
-        if (current_time->time.hours[1] > 0) {
-            current_time->time.hours[1]--;
-        } else {
-            current_time->time.hours[1] = 9;
-            current_time->time.hours[0]--;
+static uint32_t TicksToNextAlarm(clock_t self, uint32_t seconds, uint16_t clock_tick) {
+    uint32_t result = CLOCK_NO_ALARM_PENDING;
+    uint64_t ticks;
+
+    if (self->scheduled_alarms > 0) {
+        // La primera alarma de la agenda es la próxima en sonar
+        ticks = (uint64_t)AlarmDistance(&(self->alarms[self->schedule[0]]), seconds) * self->ticks_per_second - clock_tick;
+        if (ticks >= CLOCK_NO_ALARM_PENDING) {
+            ticks = CLOCK_NO_ALARM_PENDING - 1U;
         }
-    } else if (current_time->time.hours[1] > 0) {
-        current_time->time.hours[1]--;
+        result = (uint32_t)ticks;
+    }
+
+    return result;
+}
+
+static uint32_t TicksToNextWakeUp(clock_t self) {
+    uint32_t ticks = CLOCK_TICKLESS_MAX_SLEEP_SECONDS * self->ticks_per_second;
+    uint32_t boundary;
+    uint32_t alarm;
+    uint16_t clock_tick = self->current_clock_tick;
+    uint32_t seconds = self->current_seconds;
+
+    // El reloj se acaba de sincronizar, por lo que no se vuelve a leer la base de tiempo en medio de la modificación
+    alarm = TicksToNextAlarm(self, seconds, clock_tick);
+    if (alarm < ticks) {
+        ticks = alarm;
+    }
+
+    // Para notificar los cambios de segundo o de minuto, el reloj tiene que despertarse en cada uno de ellos
+    if ((self->notify != NULL) && ((self->notify_events & CLOCK_EVENT_SECOND) != 0)) {
+        boundary = self->ticks_per_second - clock_tick;
+    } else if ((self->notify != NULL) && ((self->notify_events & CLOCK_EVENT_MINUTE) != 0)) {
+        boundary = (SECONDS_PER_MINUTE - seconds % SECONDS_PER_MINUTE) * self->ticks_per_second - clock_tick;
     } else {
-        current_time->time.hours[0] = 2;
-        current_time->time.hours[1] = 3;
+        boundary = ticks;
     }
+    if (boundary < ticks) {
+        ticks = boundary;
+    }
+
+    return ticks;
 }
 
-/* === Public function definitions ================================================================================= */
+static uint32_t ClockRtosTickSource(void) {
+    return (uint32_t)xTaskGetTickCount();
+}
 
-clock_t ClockCreate(uint16_t ticks_per_second, uint16_t snooze_seconds, clock_alarm_driver_t driver) {
+static void ClockTicklessCallback(TimerHandle_t timer) {
+    clock_t self = pvTimerGetTimerID(timer);
 
-    clock_t self = malloc(sizeof(struct clock_s));
+    if ((self->lock == NULL) || (xSemaphoreTakeRecursive(self->lock, 0) == pdTRUE)) {
+        SyncTicks(self);
+        ClockEndUpdate(self);
+    } else {
+        xTimerChangePeriod(timer, 1, 0);
+    }
+}
+
+static clock_t ClockInit(clock_t self, uint16_t ticks_per_second, uint16_t snooze_seconds, clock_alarm_driver_t driver) {
     if (self != NULL) {
         self->valid_time = false;
         self->ticks_per_second = ticks_per_second;
         self->current_clock_tick = 0;
-        memset(&(self->current_time.bcd), 0, sizeof(clock_time_t));
-        memset(&(self->setted_alarm_time.bcd), 0, sizeof(clock_time_t));
-        self->activated_alarm = false;
-        self->alarm_is_ringing = false;
-        self->ringig_is_enabled = true;
-        self->snoozed_alarm = false;
-        self->seconds_count = 0;
+        self->current_seconds = 0;
         self->snooze_seconds = snooze_seconds;
-        self->alarm_driver = driver;
+        for (uint8_t alarm = 0; alarm < CLOCK_MAX_ALARMS; alarm++) {
+            self->alarms[alarm].setted_seconds = 0;
+            self->alarms[alarm].snoozed_seconds = 0;
+            self->alarms[alarm].deadline = CLOCK_INVALID_SECONDS;
+            self->alarms[alarm].activated = false;
+            self->alarms[alarm].ringing_enabled = true;
+            self->alarms[alarm].snoozed = false;
+            self->alarms[alarm].ringing = false;
+            self->alarms[alarm].alarm_driver = driver;
+        }
+        self->scheduled_alarms = 0;
+        self->tick_source = NULL;
+        self->epoch_tick = 0;
+        self->tickless_timer = NULL;
+        self->notify = NULL;
+        self->notify_context = NULL;
+        self->notify_events = 0;
+        self->pending_events = 0;
+        self->sequence = 0;
+#ifdef USE_STATIC_MEMORY
+        self->lock = xSemaphoreCreateRecursiveMutexStatic(&self->lock_buffer);
+#else
+        self->lock = xSemaphoreCreateRecursiveMutex();
+#endif
+        PublishTime(self);
+    }
+    return self;
+}
+
+/* === Public function definitions ================================================================================= */
+
+#ifndef USE_STATIC_MEMORY
+clock_t ClockCreate(uint16_t ticks_per_second, uint16_t snooze_seconds, clock_alarm_driver_t driver) {
+    clock_t self = ClockInit(malloc(sizeof(struct clock_s)), ticks_per_second, snooze_seconds, driver);
+
+    // Sin el mutex, las tareas que modifican el reloj no quedarían serializadas
+    if ((self != NULL) && (self->lock == NULL)) {
+        free(self);
+        self = NULL;
     }
+
     return self;
 }
+#endif
+
+clock_t ClockCreateStatic(clock_storage_t* storage, uint16_t ticks_per_second, uint16_t snooze_seconds, clock_alarm_driver_t driver) {
+    return ClockInit((clock_t)storage, ticks_per_second, snooze_seconds, driver);
+}
 
 bool ClockGetTime(clock_t self, clock_time_t* result) {
     bool valid;
+    struct clock_snapshot_s snapshot;
 
     if (self != NULL) {
-        if (self->valid_time) {
-            valid = true;
-        } else {
-            valid = false;
-        }
+        // Se lee la hora publicada, que siempre es consistente aunque otra tarea esté modificando el reloj
+        ReadPublishedTime(self, &snapshot);
+        valid = snapshot.valid;
 
-        memcpy(result, &(self->current_time), sizeof(clock_time_t));
+        // La vista BCD se calcula sobre la copia local, para que los lectores no escriban en el reloj
+        SecondsToTime(SnapshotSeconds(&snapshot, self->ticks_per_second, NULL), result);
 
     } else {
         valid = false;
@@ -269,6 +927,8 @@ bool ClockGetTime(clock_t self, clock_time_t* result) {
 
 bool ClockSetTime(clock_t self, const clock_time_t* time_set) {
     bool result;
+    bool was_valid;
+    uint32_t previous_seconds;
 
     if (self == NULL) {
         return false;
@@ -276,8 +936,21 @@ bool ClockSetTime(clock_t self, const clock_time_t* time_set) {
         result = CheckTimeIsValid(time_set);
 
         if (result == true) {
-            memcpy(&(self->current_time), time_set, sizeof(clock_time_t));
+            ClockBeginUpdate(self);
+            was_valid = self->valid_time;
+            previous_seconds = self->current_seconds;
+
+            self->current_seconds = TimeToSeconds(time_set);
+            self->current_clock_tick = 0;
             self->valid_time = true;
+
+            // Una resincronización que adelanta la hora por encima de una alarma no debe hacer que se pierda
+            for (uint8_t alarm = 0; (alarm < CLOCK_MAX_ALARMS) && was_valid; alarm++) {
+                if (AlarmWasSkipped(self, &(self->alarms[alarm]), previous_seconds)) {
+                    AlarmFired(self, &(self->alarms[alarm]));
+                }
+            }
+            ClockEndUpdate(self);
         }
 
         return result;
@@ -286,185 +959,356 @@ bool ClockSetTime(clock_t self, const clock_time_t* time_set) {
 
 void ClockTick(clock_t self) {
 
-    self->current_clock_tick++;
-
     if (self != NULL) {
+        ClockLock(self);
+        self->current_clock_tick++;
+
         if (self->current_clock_tick == self->ticks_per_second) {
             self->current_clock_tick = 0;
+            SecondElapsed(self);
+            PublishTime(self);
+            NotifyEvents(self);
+        }
+        ClockUnlock(self);
+    }
+}
 
-            if (self->snoozed_alarm == false) {
-                if (self->ringig_is_enabled) {
-                    if (memcmp(&(self->current_time.bcd), &(self->setted_alarm_time.bcd), sizeof(clock_time_t)) == 0) {
-                        ClockRingAlarm(self);
-                    }
-                } else {
-                    self->alarm_is_ringing = false;
-                }
+void ClockAdvance(clock_t self, uint32_t ticks) {
+    if (self != NULL) {
+        ClockBeginUpdate(self);
+        AdvanceTicks(self, ticks);
+        ClockEndUpdate(self);
+    }
+}
 
-            } else {
-                if (self->ringig_is_enabled) {
-                    if (memcmp(&(self->current_time.bcd), &(self->snoozed_alarm_time.bcd), sizeof(clock_time_t)) == 0) {
-                        self->ringig_is_enabled = true;
-                        self->alarm_is_ringing = true;
-                        self->snoozed_alarm = false;
-                        self->alarm_driver->ClockAlarmTurnOn();
-                    }
-                }
-            }
+void ClockSetNotificationSink(clock_t self, clock_notify_t notify, void* context, uint32_t events) {
+    if (self != NULL) {
+        ClockBeginUpdate(self);
+        self->notify = notify;
+        self->notify_context = context;
+        self->notify_events = events;
+        ClockEndUpdate(self);
+    }
+}
 
-            ClockTickIncrement(&(self->current_time));
+void ClockSetTickSource(clock_t self, clock_tick_source_t source) {
+    if (self != NULL) {
+        ClockLock(self);
+        SyncTicks(self);
+        self->tick_source = source;
+        if (source != NULL) {
+            self->epoch_tick = source();
         }
+        PublishTime(self);
+        NotifyEvents(self);
+        ClockUnlock(self);
     }
 }
 
-void ClockIncrementMinutes(clock_t self) {
-    if (self != NULL) {
-        IncrementMinutes(&(self->current_time));
+void ClockSync(clock_t self) {
+    if ((self != NULL) && (self->tick_source != NULL)) {
+        ClockLock(self);
+        SyncTicks(self);
+        PublishTime(self);
+        NotifyEvents(self);
+        ClockUnlock(self);
     }
 }
 
-void ClockDecrementMinutes(clock_t self) {
+uint32_t ClockGetTicksToNextAlarm(clock_t self) {
+    uint32_t result = CLOCK_NO_ALARM_PENDING;
+    uint32_t seconds;
+    uint16_t clock_tick;
+
     if (self != NULL) {
-        DecrementMinutes(&(self->current_time));
+        // La agenda solo es consistente mientras ninguna otra tarea la está reconstruyendo
+        ClockLock(self);
+        seconds = GetCurrentSeconds(self, &clock_tick);
+        result = TicksToNextAlarm(self, seconds, clock_tick);
+        ClockUnlock(self);
     }
+
+    return result;
 }
 
-void ClockIncrementHours(clock_t self) {
+void ClockAddMinutes(clock_t self, int16_t minutes) {
     if (self != NULL) {
-        IncrementHours(&(self->current_time));
+        ClockBeginUpdate(self);
+        self->current_seconds = AddMinutes(self->current_seconds, minutes);
+        ClockEndUpdate(self);
     }
 }
 
-void ClockDecrementHours(clock_t self) {
+void ClockAddHours(clock_t self, int16_t hours) {
     if (self != NULL) {
-        DecrementHours(&(self->current_time));
+        ClockBeginUpdate(self);
+        self->current_seconds = AddHours(self->current_seconds, hours);
+        ClockEndUpdate(self);
     }
 }
 
-bool ClockSetAlarm(clock_t self, const clock_time_t* time_set) {
-    bool result;
-
-    if (self == NULL) {
-        return false;
-    } else {
-        self->activated_alarm = false;
+void ClockIncrementMinutes(clock_t self) {
+    ClockAddMinutes(self, 1);
+}
 
-        result = CheckTimeIsValid(time_set);
+void ClockDecrementMinutes(clock_t self) {
+    ClockAddMinutes(self, -1);
+}
 
-        if (result == true) {
-            memcpy(&(self->setted_alarm_time.bcd), time_set, sizeof(clock_time_t));
+void ClockIncrementHours(clock_t self) {
+    ClockAddHours(self, 1);
+}
 
-            self->activated_alarm = true;
-            self->ringig_is_enabled = true;
-        }
+void ClockDecrementHours(clock_t self) {
+    ClockAddHours(self, -1);
+}
 
-        return result;
-    }
+bool ClockSetAlarm(clock_t self, const clock_time_t* time_set) {
+    return ClockSetAlarmSlot(self, 0, time_set, NULL);
 }
 
 bool ClockGetAlarm(clock_t self, clock_time_t* alarm_time) {
-    bool result = false;
-
-    if (self != NULL) {
-        if (self->activated_alarm) {
-            memcpy(alarm_time, &(self->setted_alarm_time), sizeof(clock_time_t));
-            result = true;
-        }
-    }
-    return result;
+    return ClockGetAlarmSlot(self, 0, alarm_time);
 }
 
 bool ClockGetIfAlarmIsActivated(clock_t self) {
     bool result;
-    if (self == NULL) {
+    clock_alarm_t alarm = GetAlarm(self, 0);
+
+    if (alarm == NULL) {
         result = false;
     } else {
-        result = self->activated_alarm;
+        result = alarm->activated;
     }
 
     return result;
 }
 
 void ClockDisableAlarm(clock_t self) {
-    self->activated_alarm = false;
-    self->ringig_is_enabled = false;
+    ClockDisableAlarmSlot(self, 0);
 }
 
 void ClockIncrementAlarmMinutes(clock_t self) {
-    if (self != NULL) {
-        IncrementMinutes(&(self->setted_alarm_time));
+    clock_alarm_t alarm = GetAlarm(self, 0);
+
+    if (alarm != NULL) {
+        ClockBeginUpdate(self);
+        alarm->setted_seconds = AddMinutes(alarm->setted_seconds, 1);
+        ClockEndUpdate(self);
     }
 }
 
 void ClockDecrementAlarmMinutes(clock_t self) {
-    if (self != NULL) {
-        DecrementMinutes(&(self->setted_alarm_time));
+    clock_alarm_t alarm = GetAlarm(self, 0);
+
+    if (alarm != NULL) {
+        ClockBeginUpdate(self);
+        alarm->setted_seconds = AddMinutes(alarm->setted_seconds, -1);
+        ClockEndUpdate(self);
     }
 }
 
 void ClockIncrementAlarmHours(clock_t self) {
-    if (self != NULL) {
-        IncrementHours(&(self->setted_alarm_time));
+    clock_alarm_t alarm = GetAlarm(self, 0);
+
+    if (alarm != NULL) {
+        ClockBeginUpdate(self);
+        alarm->setted_seconds = AddHours(alarm->setted_seconds, 1);
+        ClockEndUpdate(self);
     }
 }
 
 void ClockDecrementAlarmHours(clock_t self) {
-    if (self != NULL) {
-        DecrementHours(&(self->setted_alarm_time));
+    clock_alarm_t alarm = GetAlarm(self, 0);
+
+    if (alarm != NULL) {
+        ClockBeginUpdate(self);
+        alarm->setted_seconds = AddHours(alarm->setted_seconds, -1);
+        ClockEndUpdate(self);
     }
 }
 
 bool ClockRingAlarm(clock_t self) {
     bool result = false;
+    clock_alarm_t alarm = GetAlarm(self, 0);
 
-    if (self != NULL) {
-        if (ClockGetIfAlarmIsActivated(self)) {
-            self->alarm_is_ringing = true;
-            self->alarm_driver->ClockAlarmTurnOn();
+    if (alarm != NULL) {
+        ClockLock(self);
+        if (alarm->activated) {
+            alarm->ringing = true;
+            alarm->alarm_driver->ClockAlarmTurnOn();
             result = true;
         }
+        ClockUnlock(self);
     }
 
     return result;
 }
 
 bool ClockGetIfAlarmIsRinging(clock_t self) {
+    return ClockGetIfAlarmSlotIsRinging(self, 0);
+}
+
+void ClockEnableRinging(clock_t self) {
+    clock_alarm_t alarm = GetAlarm(self, 0);
+
+    if (alarm != NULL) {
+        ClockBeginUpdate(self);
+        alarm->ringing_enabled = true;
+        ClockEndUpdate(self);
+    }
+}
+
+void ClockDisableRingig(clock_t self) {
+    clock_alarm_t alarm = GetAlarm(self, 0);
+
+    if (alarm != NULL) {
+        ClockBeginUpdate(self);
+        alarm->ringing_enabled = false;
+
+        // El sonido se corta en el momento, sin esperar a que se cumpla el próximo segundo
+        if (alarm->ringing) {
+            alarm->ringing = false;
+            alarm->alarm_driver->ClockAlarmTurnOff();
+        }
+        ClockEndUpdate(self);
+    }
+}
+
+void ClockSnoozeAlarm(clock_t self) {
+    ClockSnoozeAlarmSlot(self, 0);
+}
+
+void ClockCancelAlarm(clock_t self) {
+    ClockCancelAlarmSlot(self, 0);
+}
+
+bool ClockSetAlarmSlot(clock_t self, uint8_t alarm, const clock_time_t* time_set, clock_alarm_driver_t driver) {
     bool result = false;
+    clock_alarm_t selected = GetAlarm(self, alarm);
 
-    if (self != NULL) {
-        result = self->alarm_is_ringing;
+    if (selected != NULL) {
+        ClockBeginUpdate(self);
+        selected->activated = false;
+
+        result = CheckTimeIsValid(time_set);
+
+        if (result == true) {
+            selected->setted_seconds = TimeToSeconds(time_set);
+            if (driver != NULL) {
+                selected->alarm_driver = driver;
+            }
+
+            selected->activated = true;
+            selected->ringing_enabled = true;
+        }
+        ClockEndUpdate(self);
     }
 
     return result;
 }
 
-void ClockEnableRinging(clock_t self) {
-    self->ringig_is_enabled = true;
+bool ClockGetAlarmSlot(clock_t self, uint8_t alarm, clock_time_t* alarm_time) {
+    bool result = false;
+    clock_alarm_t selected = GetAlarm(self, alarm);
+
+    if (selected != NULL) {
+        if (selected->activated) {
+            SecondsToTime(selected->setted_seconds, alarm_time);
+            result = true;
+        }
+    }
+    return result;
 }
 
-void ClockDisableRingig(clock_t self) {
-    self->ringig_is_enabled = false;
+void ClockDisableAlarmSlot(clock_t self, uint8_t alarm) {
+    clock_alarm_t selected = GetAlarm(self, alarm);
+
+    if (selected != NULL) {
+        ClockBeginUpdate(self);
+        selected->activated = false;
+        selected->ringing_enabled = false;
+        ClockEndUpdate(self);
+    }
 }
 
-void ClockSnoozeAlarm(clock_t self) {
-    clock_time_t aux = self->current_time;
-    for (uint16_t i = 0; i < self->snooze_seconds; i++) {
-        ClockTickIncrement(&aux);
+bool ClockGetIfAlarmSlotIsRinging(clock_t self, uint8_t alarm) {
+    bool result = false;
+    clock_alarm_t selected = GetAlarm(self, alarm);
+
+    if (selected != NULL) {
+        result = selected->ringing;
     }
 
-    self->snoozed_alarm_time = aux;
+    return result;
+}
+
+void ClockSnoozeAlarmSlot(clock_t self, uint8_t alarm) {
+    clock_alarm_t selected = GetAlarm(self, alarm);
+
+    if (selected != NULL) {
+        ClockBeginUpdate(self);
+        selected->snoozed_seconds = AddSeconds(self->current_seconds, self->snooze_seconds);
 
-    self->snoozed_alarm = true;
-    self->alarm_is_ringing = false;
-    self->alarm_driver->ClockAlarmTurnOff();
+        selected->snoozed = true;
+        selected->ringing = false;
+        selected->alarm_driver->ClockAlarmTurnOff();
+        ClockEndUpdate(self);
+    }
 }
 
-void ClockCancelAlarm(clock_t self) {
-    memcpy(&(self->snoozed_alarm_time.bcd), &(self->setted_alarm_time.bcd), sizeof(clock_time_t));
+void ClockCancelAlarmSlot(clock_t self, uint8_t alarm) {
+    clock_alarm_t selected = GetAlarm(self, alarm);
+
+    if (selected != NULL) {
+        ClockBeginUpdate(self);
 
-    self->snoozed_alarm = true;
-    self->alarm_is_ringing = false;
-    self->alarm_driver->ClockAlarmTurnOff();
+        // Cancelar descarta cualquier posposición: la agenda vuelve a la hora seteada, que ya pasó y queda para el día
+        // siguiente, y ese sonido se notifica como una alarma nueva y no como el vencimiento de una posposición
+        selected->snoozed = false;
+        selected->ringing = false;
+        selected->alarm_driver->ClockAlarmTurnOff();
+        ClockEndUpdate(self);
+    }
+}
+
+bool ClockTimeAddSeconds(const clock_time_t* time, int32_t seconds, clock_time_t* result) {
+    bool valid = false;
+
+    if ((time != NULL) && (result != NULL)) {
+        if (CheckTimeIsValid(time)) {
+            SecondsToTime(AddSeconds(TimeToSeconds(time), seconds), result);
+            valid = true;
+        }
+    }
+
+    return valid;
+}
+
+bool ClockTimeAddMinutes(const clock_time_t* time, int16_t minutes, clock_time_t* result) {
+    bool valid = false;
+
+    if ((time != NULL) && (result != NULL)) {
+        if (CheckTimeIsValid(time)) {
+            SecondsToTime(AddMinutes(TimeToSeconds(time), minutes), result);
+            valid = true;
+        }
+    }
+
+    return valid;
+}
+
+bool ClockTimeAddHours(const clock_time_t* time, int16_t hours, clock_time_t* result) {
+    bool valid = false;
+
+    if ((time != NULL) && (result != NULL)) {
+        if (CheckTimeIsValid(time)) {
+            SecondsToTime(AddHours(TimeToSeconds(time), hours), result);
+            valid = true;
+        }
+    }
+
+    return valid;
 }
 
 void ClockTickTask(void* clock) {
@@ -479,4 +1323,26 @@ void ClockTickTask(void* clock) {
         xTaskDelayUntil(&last_value, pdMS_TO_TICKS(1));
     }
 }
+
+bool ClockStartTickless(clock_t self) {
+    bool result = false;
+
+    if ((self != NULL) && (self->ticks_per_second == configTICK_RATE_HZ)) {
+        ClockLock(self);
+#ifdef USE_STATIC_MEMORY
+        self->tickless_timer = xTimerCreateStatic("ClockTimer", pdMS_TO_TICKS(1000), pdFALSE, self, ClockTicklessCallback, &self->tickless_timer_buffer);
+#else
+        self->tickless_timer = xTimerCreate("ClockTimer", pdMS_TO_TICKS(1000), pdFALSE, self, ClockTicklessCallback);
+#endif
+
+        if (self->tickless_timer != NULL) {
+            ClockSetTickSource(self, ClockRtosTickSource);
+            AlarmScheduleChanged(self);
+            result = true;
+        }
+        ClockUnlock(self);
+    }
+
+    return result;
+}
 /* === End of documentation ======================================================================================== */
@@ -47,19 +47,43 @@ struct digital_input_s {
     bool last_state;     //!< Último estado de la entrada digital
 };
 
+//! Falla al compilar si digital_output_storage_t no alcanza para alojar los datos internos de una salida
+typedef char digital_output_storage_size_check_t[(sizeof(digital_output_storage_t) >= sizeof(struct digital_output_s)) ? 1 : -1];
+
+//! Falla al compilar si digital_input_storage_t no alcanza para alojar los datos internos de una entrada
+typedef char digital_input_storage_size_check_t[(sizeof(digital_input_storage_t) >= sizeof(struct digital_input_s)) ? 1 : -1];
+
 /* === Private function declarations =============================================================================== */
 
+/**
+ * @brief Función interna que inicializa los datos de una salida digital recién creada y configura el pin como salida
+ *
+ * @param self Puntero a la memoria de la salida (puede ser NULL si no se pudo reservar)
+ * @param gpio_port Puerto GPIO correspondiente a la salida digital
+ * @param gpio_bit Bit específico del puerto GPIO correspondiente a la salida digital
+ * @param active_low TRUE si es una salida activa en bajo; FALSE si es una salida activa en alto
+ * @return digital_output_t El mismo puntero recibido
+ */
+static digital_output_t DigitalOutputInit(digital_output_t self, uint8_t gpio_port, uint8_t gpio_bit, bool active_low);
+
+/**
+ * @brief Función interna que inicializa los datos de una entrada digital recién creada y configura el pin como entrada
+ *
+ * @param self Puntero a la memoria de la entrada (puede ser NULL si no se pudo reservar)
+ * @param gpio_port Puerto GPIO correspondiente a la entrada digital
+ * @param gpio_bit Bit específico del puerto GPIO correspondiente a la entrada digital
+ * @param inverted_logic Determina si la entrada tiene lógica inversa o no
+ * @return digital_input_t El mismo puntero recibido
+ */
+static digital_input_t DigitalInputInit(digital_input_t self, uint8_t gpio_port, uint8_t gpio_bit, bool inverted_logic);
+
 /* === Private variable definitions ================================================================================ */
 
 /* === Public variable definitions ================================================================================= */
 
 /* === Private function definitions ================================================================================ */
 
-/* === Public function definitions ================================================================================= */
-
-digital_output_t DigitalOutputCreate(uint8_t gpio_port, uint8_t gpio_bit, bool active_low) {
-    digital_output_t self = malloc(sizeof(struct digital_output_s));
-
+static digital_output_t DigitalOutputInit(digital_output_t self, uint8_t gpio_port, uint8_t gpio_bit, bool active_low) {
     if (self != NULL) {
         self->gpio_port = gpio_port;
         self->gpio_bit = gpio_bit;
@@ -77,6 +101,31 @@ digital_output_t DigitalOutputCreate(uint8_t gpio_port, uint8_t gpio_bit, bool a
     return self;
 }
 
+static digital_input_t DigitalInputInit(digital_input_t self, uint8_t gpio_port, uint8_t gpio_bit, bool inverted_logic) {
+    if (self != NULL) {
+        self->gpio_port = gpio_port;
+        self->gpio_bit = gpio_bit;
+        self->inverted_logic = inverted_logic;
+        self->last_state = DigitalInputGetIsActive(self);
+
+        Chip_GPIO_SetPinDIR(LPC_GPIO_PORT, gpio_port, gpio_bit, false);
+    }
+
+    return self;
+}
+
+/* === Public function definitions ================================================================================= */
+
+#ifndef USE_STATIC_MEMORY
+digital_output_t DigitalOutputCreate(uint8_t gpio_port, uint8_t gpio_bit, bool active_low) {
+    return DigitalOutputInit(malloc(sizeof(struct digital_output_s)), gpio_port, gpio_bit, active_low);
+}
+#endif
+
+digital_output_t DigitalOutputCreateStatic(digital_output_storage_t* storage, uint8_t gpio_port, uint8_t gpio_bit, bool active_low) {
+    return DigitalOutputInit((digital_output_t)storage, gpio_port, gpio_bit, active_low);
+}
+
 void DigitalOutputActivate(digital_output_t self) {
     if (self->active_low == true) {
         Chip_GPIO_SetPinState(LPC_GPIO_PORT, self->gpio_port, self->gpio_bit, false);
@@ -97,19 +146,14 @@ void DigitalOutputToggle(digital_output_t self) {
     Chip_GPIO_SetPinToggle(LPC_GPIO_PORT, self->gpio_port, self->gpio_bit);
 }
 
+#ifndef USE_STATIC_MEMORY
 digital_input_t DigitalInputCreate(uint8_t gpio_port, uint8_t gpio_bit, bool inverted_logic) {
-    digital_input_t self = malloc(sizeof(struct digital_input_s));
-
-    if (self != NULL) {
-        self->gpio_port = gpio_port;
-        self->gpio_bit = gpio_bit;
-        self->inverted_logic = inverted_logic;
-        self->last_state = DigitalInputGetIsActive(self);
-
-        Chip_GPIO_SetPinDIR(LPC_GPIO_PORT, gpio_port, gpio_bit, false);
-    }
+    return DigitalInputInit(malloc(sizeof(struct digital_input_s)), gpio_port, gpio_bit, inverted_logic);
+}
+#endif
 
-    return self;
+digital_input_t DigitalInputCreateStatic(digital_input_storage_t* storage, uint8_t gpio_port, uint8_t gpio_bit, bool inverted_logic) {
+    return DigitalInputInit((digital_input_t)storage, gpio_port, gpio_bit, inverted_logic);
 }
 
 bool DigitalInputGetIsActive(digital_input_t self) {
@@ -19,106 +19,254 @@ SPDX-License-Identifier: MIT
 *********************************************************************************************************************/
 
 /** @file key_controller.c
- ** @brief Código fuente del módulo de Gestión del pulsado de las teclas
+ ** @brief Código fuente del módulo de Gestión del pulsado de las teclas, que reconoce los gestos de cada tecla y los encola
  **/
 
 /* === Headers files inclusions ==================================================================================== */
 
+#include "FreeRTOS.h"
+#include "task.h"
 #include "key_controller.h"
+#include <stddef.h>
 #include <stdlib.h>
 
 /* === Macros definitions ========================================================================================== */
 
-#ifndef KEY_TASK_DELAY_MS
-#define KEY_TASK_DELAY_MS 100
+#if (KEY_CONTROLLER_QUEUE_LENGTH < 1) || (KEY_CONTROLLER_QUEUE_LENGTH > 255)
+#error "KEY_CONTROLLER_QUEUE_LENGTH debe estar entre 1 y 255"
 #endif
 
 /* === Private data type declarations ============================================================================== */
 
-/*! Estructura de datos que representa un botón de la placa */
-struct button_s {
-    digital_input_t key;       //!< Entrada digital que representa la tecla
-    uint16_t internal_counter; //!< Cuenta interna del tiempo que fue pulsado el botón
+/*! Estructura de datos que representa un gestor de teclas */
+struct key_controller_s {
+    const key_thresholds_t* keys;                   //!< Tiempos de los gestos de cada tecla
+    key_controller_sink_t sink;                     //!< Función a la que se avisa que hay nuevos eventos (NULL si no hay)
+    void* sink_context;                             //!< Contexto que se le pasa a la función de aviso
+    uint32_t mask;                                  //!< Teclas que existen, un bit por tecla
+    uint32_t long_sent;                             //!< Teclas cuya pulsación actual ya generó la pulsación larga, un bit por tecla
+    uint32_t click_armed;                           //!< Teclas cuya última pulsación puede completar una doble pulsación, un bit por tecla
+    uint32_t lost;                                  //!< Cantidad de eventos descartados por encontrar la cola llena
+    uint32_t pressed_at[KEYBOARD_MAX_KEYS];         //!< Cuenta de ticks de la última pulsación de cada tecla
+    uint32_t next_repeat[KEYBOARD_MAX_KEYS];        //!< Tiempo de pulsación al que corresponde la próxima repetición de cada tecla
+    key_event_t queue[KEY_CONTROLLER_QUEUE_LENGTH]; //!< Cola circular de eventos
+    uint8_t head;                                   //!< Posición del evento más antiguo de la cola
+    uint8_t count;                                  //!< Cantidad de eventos en la cola
 };
 
+//! Falla al compilar si key_controller_storage_t no alcanza para alojar los datos internos del gestor de teclas
+typedef char key_controller_storage_size_check_t[(sizeof(key_controller_storage_t) >= sizeof(struct key_controller_s)) ? 1 : -1];
+
 /* === Private function declarations =============================================================================== */
 
+/**
+ * @brief Función interna que inicializa los datos de un gestor de teclas recién creado
+ *
+ * @param self Puntero a la memoria del gestor (puede ser NULL si no se pudo reservar)
+ * @param keys Arreglo con los tiempos de los gestos de cada tecla
+ * @param count Cantidad de teclas
+ * @return key_controller_t El mismo puntero recibido
+ */
+static key_controller_t KeyControllerInit(key_controller_t self, const key_thresholds_t keys[], uint8_t count);
+
+/**
+ * @brief Función interna que agrega un evento al final de la cola, o lo cuenta como perdido si la cola está llena
+ *
+ * @param self Puntero a la estructura con los datos del gestor de teclas
+ * @param key Número de la tecla
+ * @param gesture Gesto reconocido
+ * @param step Unidades que representa el evento
+ * @param now Cuenta de ticks de la lectura que produjo el evento
+ * @return true Si el evento se agregó a la cola
+ * @return false Si la cola estaba llena y el evento se descartó
+ */
+static bool QueueEvent(key_controller_t self, uint8_t key, key_gesture_t gesture, uint8_t step, uint32_t now);
+
+/**
+ * @brief Función interna que obtiene el período y las unidades de la repetición de una tecla según su tiempo de pulsación
+ *
+ * @param config Tiempos de los gestos de la tecla
+ * @param elapsed Tiempo que lleva pulsada la tecla
+ * @param step Puntero donde se guardarán las unidades que representa la repetición
+ * @return uint32_t Tiempo hasta la repetición siguiente
+ */
+static uint32_t RepeatPeriod(const key_thresholds_t* config, uint32_t elapsed, uint8_t* step);
+
+/**
+ * @brief Función interna que devuelve el número de la tecla de menor número en un conjunto de teclas
+ *
+ * @param keys Conjunto de teclas, un bit por tecla (no puede estar vacío)
+ * @return uint8_t Número de la tecla
+ */
+static uint8_t FirstKey(uint32_t keys);
+
 /* === Private variable definitions ================================================================================ */
 
 /* === Public variable definitions ================================================================================= */
 
 /* === Private function definitions ================================================================================ */
 
-/* === Public function definitions ================================================================================= */
-
-button_t ButtonCreate(digital_input_t key) {
-    button_t self = malloc(sizeof(struct button_s));
+static key_controller_t KeyControllerInit(key_controller_t self, const key_thresholds_t keys[], uint8_t count) {
+    if (count > KEYBOARD_MAX_KEYS) {
+        count = KEYBOARD_MAX_KEYS;
+    }
 
     if (self != NULL) {
-        self->key = key;
-        self->internal_counter = 0;
+        self->keys = keys;
+        self->sink = NULL;
+        self->sink_context = NULL;
+        self->mask = (count < 32) ? ((1U << count) - 1U) : 0xFFFFFFFFU;
+        self->long_sent = 0;
+        self->click_armed = 0;
+        self->lost = 0;
+        for (uint8_t key = 0; key < count; key++) {
+            self->pressed_at[key] = 0;
+            self->next_repeat[key] = 0;
+        }
+        self->head = 0;
+        self->count = 0;
     }
 
     return self;
 }
 
-bool ButtonWasPressed3secs(button_t self) {
-    bool result;
+static bool QueueEvent(key_controller_t self, uint8_t key, key_gesture_t gesture, uint8_t step, uint32_t now) {
+    key_event_t event = {.timestamp = now, .key = key, .step = step, .gesture = gesture};
+    bool result = false;
 
-    if (DigitalInputGetIsActive(self->key)) {
-        self->internal_counter++;
-        if (self->internal_counter >= 3000) {
-            result = true;
-        }
+    taskENTER_CRITICAL();
+    if (self->count < KEY_CONTROLLER_QUEUE_LENGTH) {
+        self->queue[(self->head + self->count) % KEY_CONTROLLER_QUEUE_LENGTH] = event;
+        self->count++;
+        result = true;
     } else {
-        result = false;
-        self->internal_counter = 0;
+        self->lost++;
     }
+    taskEXIT_CRITICAL();
 
     return result;
 }
 
-bool ButtonWasPressed(button_t self) {
-    return DigitalInputWasActivated(self->key);
+static uint32_t RepeatPeriod(const key_thresholds_t* config, uint32_t elapsed, uint8_t* step) {
+    uint32_t period = (config->repeat_period_ticks != 0) ? config->repeat_period_ticks : config->repeat_delay_ticks;
+
+    *step = 1;
+    for (uint8_t stage = 0; stage < config->acceleration_stages; stage++) {
+        if (elapsed >= config->acceleration[stage].after_ticks) {
+            period = config->acceleration[stage].period_ticks;
+            *step = config->acceleration[stage].step;
+        }
+    }
+
+    return period;
 }
 
-void ButtonPressedTask(void* pointer) {
-    button_task_args_t args = pointer;
+static uint8_t FirstKey(uint32_t keys) {
+    return (uint8_t)__builtin_ctz(keys);
+}
 
-    while (true) {
-        while (DigitalInputGetIsActive(((digital_input_t)args->key)) == false) {
-            vTaskDelay(pdMS_TO_TICKS(KEY_TASK_DELAY_MS));
-        }
+/* === Public function definitions ================================================================================= */
+
+#ifndef USE_STATIC_MEMORY
+key_controller_t KeyControllerCreate(const key_thresholds_t keys[], uint8_t count) {
+    return KeyControllerInit(malloc(sizeof(struct key_controller_s)), keys, count);
+}
+#endif
 
-        xEventGroupSetBits(args->event_group, (EventBits_t)args->event_mask);
+key_controller_t KeyControllerCreateStatic(key_controller_storage_t* storage, const key_thresholds_t keys[], uint8_t count) {
+    return KeyControllerInit((key_controller_t)storage, keys, count);
+}
 
-        while (DigitalInputGetIsActive(((digital_input_t)args->key)) == true) {
-            vTaskDelay(pdMS_TO_TICKS(KEY_TASK_DELAY_MS));
-        }
+void KeyControllerSetNotificationSink(key_controller_t self, key_controller_sink_t sink, void* context) {
+    if (self != NULL) {
+        self->sink = sink;
+        self->sink_context = context;
     }
 }
 
-void ButtonPressed3secsTask(void* pointer) {
-    button_task_args_t args = pointer;
-    TickType_t initial_ticks;
-    TickType_t current_tick;
+void KeyControllerProcess(key_controller_t self, const keyboard_events_t* events, uint32_t now) {
+    const key_thresholds_t* key_config;
+    uint32_t pending;
+    uint32_t elapsed;
+    bool queued = false;
+    uint8_t step;
+    uint8_t key;
 
-    while (true) {
-        while (DigitalInputGetIsActive(((digital_input_t)args->key)) == false) {
-            vTaskDelay(pdMS_TO_TICKS(KEY_TASK_DELAY_MS));
+    if (self != NULL) {
+        pending = events->released & self->mask;
+        while (pending != 0) {
+            queued |= QueueEvent(self, FirstKey(pending), KEY_GESTURE_RELEASE, 1, now);
+            pending &= pending - 1U;
+        }
+
+        pending = events->pressed & self->mask;
+        while (pending != 0) {
+            key = FirstKey(pending);
+            key_config = &self->keys[key];
+            queued |= QueueEvent(self, key, KEY_GESTURE_PRESS, 1, now);
+
+            // La doble pulsación se mide entre dos pulsaciones, y la que la completa no puede iniciar otra
+            if ((self->click_armed & (1U << key)) && (now - self->pressed_at[key] <= key_config->double_click_ticks)) {
+                queued |= QueueEvent(self, key, KEY_GESTURE_DOUBLE_CLICK, 1, now);
+                self->click_armed &= ~(1U << key);
+            } else if (key_config->double_click_ticks != 0) {
+                self->click_armed |= (1U << key);
+            }
+
+            self->pressed_at[key] = now;
+            self->next_repeat[key] = key_config->repeat_delay_ticks;
+            self->long_sent &= ~(1U << key);
+            pending &= pending - 1U;
         }
 
-        initial_ticks = xTaskGetTickCount();
+        // Las teclas que siguen pulsadas desde una lectura anterior pueden cumplir su pulsación larga o repetirse
+        pending = events->down & ~events->pressed & self->mask;
+        while (pending != 0) {
+            key = FirstKey(pending);
+            key_config = &self->keys[key];
+            elapsed = now - self->pressed_at[key];
 
-        while (DigitalInputGetIsActive(((digital_input_t)args->key)) == true) {
-            current_tick = xTaskGetTickCount();
-            vTaskDelay(pdMS_TO_TICKS(10));
+            if ((key_config->long_press_ticks != 0) && !(self->long_sent & (1U << key)) && (elapsed >= key_config->long_press_ticks)) {
+                queued |= QueueEvent(self, key, KEY_GESTURE_LONG_PRESS, 1, now);
+                self->long_sent |= (1U << key);
+            }
 
-            if (current_tick - initial_ticks >= pdMS_TO_TICKS(3000)) {
-                xEventGroupSetBits(args->event_group, (EventBits_t)args->event_mask);
+            if ((key_config->repeat_delay_ticks != 0) && (elapsed >= self->next_repeat[key])) {
+                self->next_repeat[key] += RepeatPeriod(key_config, elapsed, &step);
+                queued |= QueueEvent(self, key, KEY_GESTURE_REPEAT, step, now);
             }
+            pending &= pending - 1U;
+        }
+
+        if (queued && (self->sink != NULL)) {
+            self->sink(self->sink_context);
         }
     }
 }
 
+bool KeyControllerGetEvent(key_controller_t self, key_event_t* event) {
+    bool result = false;
+
+    if (self != NULL) {
+        taskENTER_CRITICAL();
+        if (self->count > 0) {
+            *event = self->queue[self->head];
+            self->head = (uint8_t)((self->head + 1) % KEY_CONTROLLER_QUEUE_LENGTH);
+            self->count--;
+            result = true;
+        }
+        taskEXIT_CRITICAL();
+    }
+
+    return result;
+}
+
+uint32_t KeyControllerGetLostEvents(key_controller_t self) {
+    return (self != NULL) ? self->lost : 0;
+}
+
+void KeyControllerKeyboardHandler(void* controller, const keyboard_events_t* events, uint32_t now) {
+    KeyControllerProcess(controller, events, now);
+}
+
 /* === End of documentation ======================================================================================== */
@@ -0,0 +1,154 @@
+/*********************************************************************************************************************
+Copyright (c) 2025, Facundo Sonzogni <facundosonzogni1@gmail.com>
+Copyright (c) 2025, Laboratorio de Microprocesadores, Universidad Nacional de Tucumán
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*********************************************************************************************************************/
+
+/** @file keyboard.c
+ ** @brief Código fuente del módulo de Teclado, que lee todas las teclas de una vez y las procesa con antirrebote
+ **/
+
+/* === Headers files inclusions ==================================================================================== */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "keyboard.h"
+#include <stddef.h>
+#include <stdlib.h>
+
+/* === Macros definitions ========================================================================================== */
+
+/* === Private data type declarations ============================================================================== */
+
+/*! Estructura de datos que representa un Teclado */
+struct keyboard_s {
+    TaskHandle_t volatile task; //!< Tarea que procesa el teclado (NULL mientras no comenzó)
+    uint32_t mask;              //!< Teclas que existen en el teclado, un bit por tecla
+    uint32_t stable;            //!< Estado aceptado (sin rebotes) de cada tecla, un bit por tecla
+    uint32_t count_low;         //!< Bit menos significativo del contador de antirrebote de cada tecla
+    uint32_t count_high;        //!< Bit más significativo del contador de antirrebote de cada tecla
+};
+
+//! Falla al compilar si keyboard_storage_t no alcanza para alojar los datos internos del teclado
+typedef char keyboard_storage_size_check_t[(sizeof(keyboard_storage_t) >= sizeof(struct keyboard_s)) ? 1 : -1];
+
+/* === Private function declarations =============================================================================== */
+
+/**
+ * @brief Función interna que inicializa los datos de un teclado recién creado
+ *
+ * @param self Puntero a la memoria del teclado (puede ser NULL si no se pudo reservar)
+ * @param count Cantidad de teclas
+ * @return keyboard_t El mismo puntero recibido
+ */
+static keyboard_t KeyboardInit(keyboard_t self, uint8_t count);
+
+/* === Private variable definitions ================================================================================ */
+
+/* === Public variable definitions ================================================================================= */
+
+/* === Private function definitions ================================================================================ */
+
+static keyboard_t KeyboardInit(keyboard_t self, uint8_t count) {
+    if (count > KEYBOARD_MAX_KEYS) {
+        count = KEYBOARD_MAX_KEYS;
+    }
+
+    if (self != NULL) {
+        self->task = NULL;
+        self->mask = (count < 32) ? ((1U << count) - 1U) : 0xFFFFFFFFU;
+        self->stable = 0;
+        self->count_low = 0;
+        self->count_high = 0;
+    }
+
+    return self;
+}
+
+/* === Public function definitions ================================================================================= */
+
+#ifndef USE_STATIC_MEMORY
+keyboard_t KeyboardCreate(uint8_t count) {
+    return KeyboardInit(malloc(sizeof(struct keyboard_s)), count);
+}
+#endif
+
+keyboard_t KeyboardCreateStatic(keyboard_storage_t* storage, uint8_t count) {
+    return KeyboardInit((keyboard_t)storage, count);
+}
+
+void KeyboardScan(keyboard_t self, uint32_t sample, keyboard_events_t* events) {
+    uint32_t changed;
+    uint32_t toggled;
+
+    events->pressed = 0;
+    events->released = 0;
+    events->down = 0;
+
+    if (self != NULL) {
+        // Cada tecla distinta de su estado aceptado avanza su contador, y las que coinciden lo vuelven a cero
+        changed = (sample & self->mask) ^ self->stable;
+        self->count_high = (self->count_high ^ self->count_low) & changed;
+        self->count_low = ~self->count_low & changed;
+
+        // El contador de dos bits vuelve a cero luego de KEYBOARD_DEBOUNCE_SCANS lecturas distintas seguidas
+        toggled = changed & ~(self->count_low | self->count_high);
+        self->stable ^= toggled;
+
+        events->pressed = toggled & self->stable;
+        events->released = toggled & ~self->stable;
+        events->down = self->stable;
+    }
+}
+
+bool KeyboardIsIdle(keyboard_t self) {
+    return (self == NULL) || ((self->stable | self->count_low | self->count_high) == 0);
+}
+
+void KeyboardWakeFromISR(void* keyboard) {
+    keyboard_t self = keyboard;
+    BaseType_t task_woken = pdFALSE;
+
+    if ((self != NULL) && (self->task != NULL)) {
+        vTaskNotifyGiveFromISR(self->task, &task_woken);
+    }
+    portYIELD_FROM_ISR(task_woken);
+}
+
+void KeyboardTask(void* arguments) {
+    keyboard_task_args_t args = arguments;
+    keyboard_events_t events;
+    TickType_t last_scan;
+
+    args->keyboard->task = xTaskGetCurrentTaskHandle();
+    last_scan = xTaskGetTickCount();
+
+    while (true) {
+        // Se lee antes de bloquearse, para atender las teclas pulsadas antes de que comience la tarea
+        KeyboardScan(args->keyboard, args->read(), &events);
+        args->handler(args->context, &events, (uint32_t)last_scan);
+
+        if (KeyboardIsIdle(args->keyboard)) {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            last_scan = xTaskGetTickCount();
+        } else {
+            xTaskDelayUntil(&last_scan, pdMS_TO_TICKS(KEYBOARD_SCAN_PERIOD_MS));
+        }
+    }
+}
+
+/* === End of documentation ======================================================================================== */
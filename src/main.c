@@ -31,19 +31,43 @@ SPDX-License-Identifier: MIT
 #include "chip.h"
 #include "clock.h"
 #include "key_controller.h"
+#include "keyboard.h"
+#include "mef.h"
 #include "AppMEF.h"
 #include <stdbool.h>
 #include <string.h>
-#include <stdlib.h>
 
 /* === Macros definitions ====================================================================== */
 
-#define SET_TIME_BUTTON  KEY_EVENT_KEY_0 //!< Representa que el evento generado por el "set_time" corresponde al bit 0 del grupo de eventos
-#define INCREMENT_BUTTON KEY_EVENT_KEY_1 //!< Representa que el evento generado por el "increment" corresponde al bit 1 del grupo de eventos
-#define DECREMENT_BUTTON KEY_EVENT_KEY_2 //!< Representa que el evento generado por el "decrement" corresponde al bit 2 del grupo de eventos
-#define ACCEPT_BUTTON    KEY_EVENT_KEY_3 //!< Representa que el evento generado por el "accept" corresponde al bit 3 del grupo de eventos
-#define CANCEL_BUTTON    KEY_EVENT_KEY_4 //!< Representa que el evento generado por el "cancel" corresponde al bit 4 del grupo de eventos
-#define SET_ALARM_BUTTON KEY_EVENT_KEY_5 //!< Representa que el evento generado por el "set_alarm" corresponde al bit 5 del grupo de eventos
+#define SET_TIME_BUTTON      BOARD_KEY_F1     //!< Tecla que cumple la función de "set_time"
+#define INCREMENT_BUTTON     BOARD_KEY_F4     //!< Tecla que cumple la función de "increment"
+#define DECREMENT_BUTTON     BOARD_KEY_F3     //!< Tecla que cumple la función de "decrement"
+#define ACCEPT_BUTTON        BOARD_KEY_ACCEPT //!< Tecla que cumple la función de "accept"
+#define CANCEL_BUTTON        BOARD_KEY_CANCEL //!< Tecla que cumple la función de "cancel"
+#define SET_ALARM_BUTTON     BOARD_KEY_F2     //!< Tecla que cumple la función de "set_alarm"
+
+#define KEYS_HOLD_MS         3000 //!< Tiempo que deben mantenerse pulsadas las teclas "set_time" y "set_alarm"
+#define KEYS_REPEAT_DELAY_MS 600  //!< Tiempo que debe mantenerse pulsada "increment" o "decrement" para que empiece a repetirse
+#define KEYS_REPEAT_SLOW_MS  250  //!< Período de repetición durante el primer segundo de repetición
+#define KEYS_REPEAT_FAST_AT  1600 //!< Tiempo de pulsación a partir del cual la repetición se acelera
+#define KEYS_REPEAT_FAST_MS  80   //!< Período de repetición acelerado
+#define KEYS_REPEAT_TENS_AT  4000 //!< Tiempo de pulsación a partir del cual cada repetición avanza diez unidades
+#define KEYS_REPEAT_TENS_MS  250  //!< Período de repetición al avanzar de a diez unidades
+
+#define INACTIVITY_TIMEOUT_MS 30000 //!< Tiempo sin pulsaciones luego del cual se cancelan los ajustes de la hora y la alarma
+
+#ifdef USE_STATIC_MEMORY
+//! Crea una tarea cuya pila y bloque de control se reservan en memoria estática (cada uso reserva su propia memoria)
+#define TASK_CREATE(result, function, name, stack_size, args, priority)                                                                                                                                \
+    do {                                                                                                                                                                                               \
+        static StackType_t task_stack[stack_size];                                                                                                                                                     \
+        static StaticTask_t task_buffer;                                                                                                                                                               \
+        result = (xTaskCreateStatic(function, name, stack_size, args, priority, task_stack, &task_buffer) != NULL) ? pdPASS : pdFAIL;                                                                  \
+    } while (0)
+#else
+//! Crea una tarea cuya pila y bloque de control se reservan en el heap de FreeRTOS
+#define TASK_CREATE(result, function, name, stack_size, args, priority) result = xTaskCreate(function, name, stack_size, args, priority, NULL)
+#endif
 
 /* === Private data type declarations ========================================================== */
 
@@ -79,6 +103,52 @@ static const struct clock_alarm_driver_s driver = {
     .ClockAlarmTurnOff = ClockAlarmTurnOff,
 };
 
+//! Aceleración de la repetición de "increment" y "decrement": primero más rápida y después de a diez unidades
+static const key_repeat_stage_t repeat_acceleration[] = {
+    {.after_ticks = pdMS_TO_TICKS(KEYS_REPEAT_FAST_AT), .period_ticks = pdMS_TO_TICKS(KEYS_REPEAT_FAST_MS), .step = 1},
+    {.after_ticks = pdMS_TO_TICKS(KEYS_REPEAT_TENS_AT), .period_ticks = pdMS_TO_TICKS(KEYS_REPEAT_TENS_MS), .step = 10},
+};
+
+//! Tiempos de los gestos de cada tecla (las teclas que no figuran solo generan pulsaciones y liberaciones)
+static const key_thresholds_t keys[BOARD_KEYS] = {
+    [SET_TIME_BUTTON] = {.long_press_ticks = pdMS_TO_TICKS(KEYS_HOLD_MS)},
+    [SET_ALARM_BUTTON] = {.long_press_ticks = pdMS_TO_TICKS(KEYS_HOLD_MS)},
+    [INCREMENT_BUTTON] = {.repeat_delay_ticks = pdMS_TO_TICKS(KEYS_REPEAT_DELAY_MS),
+                          .repeat_period_ticks = pdMS_TO_TICKS(KEYS_REPEAT_SLOW_MS),
+                          .acceleration = repeat_acceleration,
+                          .acceleration_stages = sizeof(repeat_acceleration) / sizeof(repeat_acceleration[0])},
+    [DECREMENT_BUTTON] = {.repeat_delay_ticks = pdMS_TO_TICKS(KEYS_REPEAT_DELAY_MS),
+                          .repeat_period_ticks = pdMS_TO_TICKS(KEYS_REPEAT_SLOW_MS),
+                          .acceleration = repeat_acceleration,
+                          .acceleration_stages = sizeof(repeat_acceleration) / sizeof(repeat_acceleration[0])},
+};
+
+//! Argumentos de la tarea del teclado (existen durante toda la ejecución del programa)
+static struct keyboard_task_args_s keyboard_args;
+
+//! Argumentos de la tarea de la MEF
+static struct mef_task_args_s mef_args;
+
+#ifdef USE_STATIC_MEMORY
+//! Memoria de la placa, sus entradas, salidas y pantalla
+static board_storage_t board_storage;
+
+//! Memoria del reloj
+static clock_storage_t clock_storage;
+
+//! Memoria del teclado
+static keyboard_storage_t keyboard_storage;
+
+//! Memoria del gestor de teclas
+static key_controller_storage_t key_controller_storage;
+
+//! Memoria de la MEF del reloj despertador
+static mef_storage_t mef_storage;
+
+//! Memoria del grupo de eventos de los botones
+static StaticEventGroup_t buttons_events_storage;
+#endif
+
 /* === Private variable definitions ============================================================ */
 
 /* === Private function implementation ========================================================= */
@@ -93,93 +163,126 @@ static void ClockAlarmTurnOff(void) {
 
 /* === Public function implementation ========================================================== */
 
+#ifdef USE_STATIC_MEMORY
+//! Función que le indica a FreeRTOS la memoria estática de la tarea ociosa (Idle)
+void vApplicationGetIdleTaskMemory(StaticTask_t** task_buffer, StackType_t** stack_buffer, uint32_t* stack_size) {
+    static StaticTask_t idle_task_buffer;
+    static StackType_t idle_task_stack[configMINIMAL_STACK_SIZE];
+
+    *task_buffer = &idle_task_buffer;
+    *stack_buffer = idle_task_stack;
+    *stack_size = configMINIMAL_STACK_SIZE;
+}
+
+//! Función que le indica a FreeRTOS la memoria estática de la tarea de los temporizadores
+void vApplicationGetTimerTaskMemory(StaticTask_t** task_buffer, StackType_t** stack_buffer, uint32_t* stack_size) {
+    static StaticTask_t timer_task_buffer;
+    static StackType_t timer_task_stack[configTIMER_TASK_STACK_DEPTH];
+
+    *task_buffer = &timer_task_buffer;
+    *stack_buffer = timer_task_stack;
+    *stack_size = configTIMER_TASK_STACK_DEPTH;
+}
+#endif
+
+#ifdef USE_RUNTIME_STATS
+//! Función que le indica a FreeRTOS el tiempo transcurrido, en centésimas de tick, para medir el uso de CPU de cada tarea
+uint32_t ulGetRunTimeCounterValue(void) {
+    TickType_t ticks;
+    uint32_t value;
+    bool pending;
+
+    // Las lecturas se repiten si en medio se atendió el tick o se recargó el SysTick, para que la cuenta de ticks, el
+    // valor del SysTick y el pedido de su interrupción correspondan al mismo período. No se usa COUNTFLAG porque
+    // leerlo lo borra
+    do {
+        ticks = xTaskGetTickCountFromISR();
+        value = SysTick->VAL;
+        pending = (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) != 0;
+    } while ((SysTick->VAL > value) || (ticks != xTaskGetTickCountFromISR()));
+
+    // Si el SysTick ya se recargó pero su interrupción todavía no se atendió (por ejemplo, durante el cambio de
+    // contexto, que la enmascara), el período en curso corresponde al tick siguiente
+    if (pending) {
+        ticks++;
+    }
+
+    return (ticks * 100U) + ((SysTick->LOAD - value) * 100U / (SysTick->LOAD + 1U));
+}
+#endif
+
 //! Programa principal con la aplicación deseada
 int main(void) {
 
     EventGroupHandle_t buttons_events;
-    BaseType_t result;
-
+    key_controller_t key_controller;
+    BaseType_t result = pdFAIL;
+
+#ifdef USE_STATIC_MEMORY
+    board = BoardCreateStatic(&board_storage);
+    clock = ClockCreateStatic(&clock_storage, 1000, 300, &driver);
+    keyboard_args.keyboard = KeyboardCreateStatic(&keyboard_storage, BOARD_KEYS);
+    key_controller = KeyControllerCreateStatic(&key_controller_storage, keys, BOARD_KEYS);
+    mef_args.mef = MEFCreateStatic(&mef_storage, clock, board->screen, pdMS_TO_TICKS(INACTIVITY_TIMEOUT_MS));
+
+    buttons_events = xEventGroupCreateStatic(&buttons_events_storage);
+#else
     board = BoardCreate();
     clock = ClockCreate(1000, 300, &driver);
+    keyboard_args.keyboard = KeyboardCreate(BOARD_KEYS);
+    key_controller = KeyControllerCreate(keys, BOARD_KEYS);
+    mef_args.mef = MEFCreate(clock, board->screen, pdMS_TO_TICKS(INACTIVITY_TIMEOUT_MS));
 
     buttons_events = xEventGroupCreate();
+#endif
 
-    /*================= Creación de todas las tareas correspondientes a los botones ==================*/
+    /*============= La MEF redibuja la hora solo cuando el reloj le notifica un cambio de minuto ============*/
     if (buttons_events != NULL) {
-        button_task_args_t buttons_args = malloc(sizeof(*buttons_args));
-        buttons_args->event_group = buttons_events;
-        buttons_args->event_mask = SET_TIME_BUTTON;
-        buttons_args->key = board->key_F1;
-        result = xTaskCreate(ButtonPressed3secsTask, "SetTimeTask", KEY_TASK_STACK_SIZE, buttons_args, tskIDLE_PRIORITY + 1, NULL);
-    }
-
-    if (result == pdPASS) {
-        button_task_args_t buttons_args = malloc(sizeof(*buttons_args));
-        buttons_args->event_group = buttons_events;
-        buttons_args->event_mask = INCREMENT_BUTTON;
-        buttons_args->key = board->key_F4;
-        result = xTaskCreate(ButtonPressedTask, "IncrementTimeTask", KEY_TASK_STACK_SIZE, buttons_args, tskIDLE_PRIORITY + 1, NULL);
-    }
-
-    if (result == pdPASS) {
-        button_task_args_t buttons_args = malloc(sizeof(*buttons_args));
-        buttons_args->event_group = buttons_events;
-        buttons_args->event_mask = DECREMENT_BUTTON;
-        buttons_args->key = board->key_F3;
-        result = xTaskCreate(ButtonPressedTask, "DecrementTimeTask", KEY_TASK_STACK_SIZE, buttons_args, tskIDLE_PRIORITY + 1, NULL);
+        ClockSetNotificationSink(clock, MEFClockNotify, buttons_events, CLOCK_EVENT_MINUTE);
     }
 
-    if (result == pdPASS) {
-        button_task_args_t buttons_args = malloc(sizeof(*buttons_args));
-        buttons_args->event_group = buttons_events;
-        buttons_args->event_mask = ACCEPT_BUTTON;
-        buttons_args->key = board->key_accept;
-        result = xTaskCreate(ButtonPressedTask, "AcceptPressedTask", KEY_TASK_STACK_SIZE, buttons_args, tskIDLE_PRIORITY + 1, NULL);
-    }
+    /*===== Una única tarea lee todas las teclas de una vez, despertada por las interrupciones de sus pines =====*/
+    /*===== y el gestor de teclas encola sus gestos para que la MEF los consuma sin perder ninguno =====*/
+    if (buttons_events != NULL) {
+        KeyControllerSetNotificationSink(key_controller, MEFKeyNotify, buttons_events);
 
-    if (result == pdPASS) {
-        button_task_args_t buttons_args = malloc(sizeof(*buttons_args));
-        buttons_args->event_group = buttons_events;
-        buttons_args->event_mask = CANCEL_BUTTON;
-        buttons_args->key = board->key_cancel;
-        result = xTaskCreate(ButtonPressedTask, "CancelPressedTask", KEY_TASK_STACK_SIZE, buttons_args, tskIDLE_PRIORITY + 1, NULL);
+        keyboard_args.read = BoardReadKeys;
+        keyboard_args.handler = KeyControllerKeyboardHandler;
+        keyboard_args.context = key_controller;
+        TASK_CREATE(result, KeyboardTask, "KeyboardTask", KEYBOARD_TASK_STACK_SIZE, &keyboard_args, tskIDLE_PRIORITY + 1);
     }
 
     if (result == pdPASS) {
-        button_task_args_t buttons_args = malloc(sizeof(*buttons_args));
-        buttons_args->event_group = buttons_events;
-        buttons_args->event_mask = SET_ALARM_BUTTON;
-        buttons_args->key = board->key_F2;
-        result = xTaskCreate(ButtonPressed3secsTask, "SetAlarmTask", KEY_TASK_STACK_SIZE, buttons_args, tskIDLE_PRIORITY + 1, NULL);
+        BoardEnableKeyInterrupts(board, KeyboardWakeFromISR, keyboard_args.keyboard);
     }
 
     /* ====================== Creación de la tarea correspondiente a la MEF ========================== */
 
     if (result == pdPASS) {
-        mef_task_args_t mef_args = malloc(sizeof(*mef_args));
-        mef_args->board = board;
-        mef_args->clock = clock;
-        mef_args->set_time_mask = SET_TIME_BUTTON;
-        mef_args->increment_mask = INCREMENT_BUTTON;
-        mef_args->decrement_mask = DECREMENT_BUTTON;
-        mef_args->accept_mask = ACCEPT_BUTTON;
-        mef_args->cancel_mask = CANCEL_BUTTON;
-        mef_args->set_alarm_mask = SET_ALARM_BUTTON;
-        mef_args->event_group = buttons_events;
-
-        result = xTaskCreate(MEFTask, "MEFTask", configMINIMAL_STACK_SIZE, mef_args, tskIDLE_PRIORITY + 2, NULL);
+        mef_args.keys = key_controller;
+        mef_args.set_time_key = SET_TIME_BUTTON;
+        mef_args.increment_key = INCREMENT_BUTTON;
+        mef_args.decrement_key = DECREMENT_BUTTON;
+        mef_args.accept_key = ACCEPT_BUTTON;
+        mef_args.cancel_key = CANCEL_BUTTON;
+        mef_args.set_alarm_key = SET_ALARM_BUTTON;
+        mef_args.event_group = buttons_events;
+
+        TASK_CREATE(result, MEFTask, "MEFTask", configMINIMAL_STACK_SIZE, &mef_args, tskIDLE_PRIORITY + 2);
     }
 
-    /* ============== Creación de la tarea correspondiente al Refresco de Pantalla  ================== */
+    /* ========= El refresco de pantalla lo hace la interrupción de un temporizador, sin ninguna tarea ========= */
 
     if (result == pdPASS) {
-        result = xTaskCreate(ScreenRefreshTask, "ScreenRefresh", configMINIMAL_STACK_SIZE, board->screen, tskIDLE_PRIORITY + 3, NULL);
+        BoardStartScreenTimer(board, SCREEN_REFRESH_FREQUENCY, ScreenRefreshFromISR, board->screen);
     }
 
-    /* =============== Creación de la tarea correspondiente al Refresco del Reloj  =================== */
+    /* ========== Reloj en modo sin tick: la hora se deriva de la cuenta de ticks de FreeRTOS ========== */
 
     if (result == pdPASS) {
-        result = xTaskCreate(ClockTickTask, "ClockTick", configMINIMAL_STACK_SIZE, clock, tskIDLE_PRIORITY + 4, NULL);
+        if (!ClockStartTickless(clock)) {
+            result = pdFAIL;
+        }
     }
 
     vTaskStartScheduler();
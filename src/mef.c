@@ -0,0 +1,529 @@
+/*********************************************************************************************************************
+Copyright (c) 2025, Facundo Sonzogni <facundosonzogni1@gmail.com>
+Copyright (c) 2025, Laboratorio de Microprocesadores, Universidad Nacional de Tucumán
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*********************************************************************************************************************/
+
+
+/** @file mef.c
+ ** @brief Código fuente del núcleo de la Máquina de Estado Finito del reloj despertador, independiente de FreeRTOS
+ **/
+
+/* === Headers files inclusions ==================================================================================== */
+
+#include "mef.h"
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* === Macros definitions ========================================================================================== */
+
+#define MEF_FLASH_HALF_PERIOD 125 //!< Semi-período de parpadeo de los dígitos y del punto, en ciclos de refresco
+
+/* === Private data type declarations ============================================================================== */
+
+//! Estructura de datos con el contexto de la MEF
+struct mef_s {
+    clock_t clock;                      //!< Reloj cuya hora y alarma se muestran y se ajustan
+    screen_t screen;                    //!< Pantalla en la que se dibuja cada estado
+    uint32_t timeouts[MEF_STATE_COUNT]; //!< Tiempo sin pulsaciones de cada estado, en ticks (MEF_NO_TIMEOUT si no tiene)
+    uint32_t armed_at;                  //!< Cuenta de ticks en la que se armó el plazo del estado actual
+    uint32_t armed_timeout;             //!< Duración del plazo armado, en ticks (MEF_NO_TIMEOUT si no hay un plazo armado)
+    mef_state_t state;                  //!< Estado actual de la MEF
+    clock_time_t current_time;          //!< Hora leída al mostrarla o al comenzar a ajustarla (se restaura al cancelar)
+    clock_time_t adjusted_time;         //!< Hora que se está ajustando
+    clock_time_t alarm_time;            //!< Hora de la alarma confirmada por el usuario
+    clock_time_t adjusted_alarm_time;   //!< Hora de la alarma que se está ajustando
+    bool valid_time;                    //!< Indica si la hora del reloj era válida al leerla
+    bool alarm_is_activated;            //!< Indica que la alarma está activada (no que está sonando)
+    uint8_t step;                       //!< Cantidad de unidades del evento que se está procesando
+};
+
+//! Falla al compilar si mef_storage_t no alcanza para alojar los datos internos de la MEF
+typedef char mef_storage_size_check_t[(sizeof(mef_storage_t) >= sizeof(struct mef_s)) ? 1 : -1];
+
+/**
+ * @brief Tipo de dato que representa una acción de la MEF (de una transición o de la entrada a un estado)
+ *
+ * @param self Contexto de la MEF
+ * @param next Estado siguiente indicado en la tabla de transiciones (o MEF_STATE_UNCHANGED)
+ * @return mef_state_t Estado siguiente, que la acción puede cambiar cuando depende de una condición
+ */
+typedef mef_state_t (*mef_action_t)(mef_t self, mef_state_t next);
+
+//! Tipo de dato que representa la función que se ejecuta al salir de un estado
+typedef void (*mef_exit_t)(mef_t self);
+
+//! Estructura de datos que describe un campo que se ajusta con las teclas "increment" y "decrement"
+typedef struct mef_field_s {
+    bool alarm;                                                 //!< Indica si el campo pertenece a la hora de la alarma en lugar de a la hora actual
+    bool accelerated;                                           //!< Indica si el campo avanza los pasos de la repetición acelerada o siempre de a uno
+    uint8_t from;                                               //!< Primer dígito que parpadea mientras se ajusta el campo
+    uint8_t to;                                                 //!< Último dígito que parpadea mientras se ajusta el campo
+    void (*add)(clock_t, int16_t);                              //!< Función del reloj que suma unidades al campo de la hora actual (solo campos de la hora)
+    bool (*shift)(const clock_time_t*, int16_t, clock_time_t*); //!< Función que suma unidades al campo de la alarma ajustada (solo campos de la alarma)
+} const* mef_field_t;
+
+//! Estructura de datos que describe un estado de la MEF
+typedef struct mef_state_info_s {
+    mef_action_t entry; //!< Acción que se ejecuta al entrar al estado (dibuja el estado en la pantalla)
+    mef_exit_t exit;    //!< Función que se ejecuta al salir del estado (puede ser NULL)
+    mef_field_t field;  //!< Campo que se ajusta en el estado (NULL si el estado no ajusta ningún campo)
+} mef_state_info_t;
+
+//! Estructura de datos que representa una transición de la MEF
+typedef struct mef_transition_s {
+    mef_action_t action; //!< Acción de la transición (NULL si la entrada no produce ninguna acción)
+    uint8_t next;        //!< Estado siguiente (mef_state_t), o MEF_STATE_UNCHANGED para permanecer en el mismo estado
+} mef_transition_t;
+
+/* === Private function declarations =============================================================================== */
+
+/**
+ * @brief Función interna que inicializa los datos de una MEF recién creada
+ *
+ * @param self Puntero a la memoria de la MEF (puede ser NULL si no se pudo reservar)
+ * @param clock Reloj cuya hora y alarma se muestran y se ajustan
+ * @param screen Pantalla en la que se dibuja cada estado
+ * @param timeout Tiempo sin pulsaciones, en ticks, de todos los estados que atienden MEF_INPUT_TIMEOUT
+ * @return mef_t El mismo puntero recibido
+ */
+static mef_t MEFInit(mef_t self, clock_t clock, screen_t screen, uint32_t timeout);
+
+/**
+ * @brief Función que arma el plazo sin pulsaciones del estado actual, a partir de la cuenta de ticks indicada
+ *
+ * @param self Contexto de la MEF
+ * @param now Cuenta de ticks actual
+ *
+ * NOTA: Si la tabla de transiciones no atiende MEF_INPUT_TIMEOUT en el estado actual, o el estado no tiene un tiempo
+ * configurado, el plazo queda desarmado
+ */
+static void ArmDeadline(mef_t self, uint32_t now);
+
+/**
+ * @brief Función que atiende una entrada en el estado actual, recorriendo una única fila de la tabla de transiciones
+ *
+ * @param self Contexto de la MEF
+ * @param input Entrada que se atiende
+ * @param now Cuenta de ticks actual
+ */
+static void Dispatch(mef_t self, mef_input_t input, uint32_t now);
+
+/**
+ * @brief Función que cambia el estado de la MEF
+ *
+ * @param self Contexto de la MEF
+ * @param next Estado al que se pasa
+ *
+ * NOTA: Se ejecuta la función de salida del estado anterior y la de entrada del nuevo, y esta última puede a su vez
+ * derivar a otro estado (por ejemplo, al encontrar que la hora no es válida)
+ */
+static void ChangeState(mef_t self, mef_state_t next);
+
+//! Acción de entrada del estado de hora inválida: muestra la última hora leída con todos los dígitos parpadeando
+static mef_state_t DrawInvalidTime(mef_t self, mef_state_t next);
+
+//! Acción que muestra la hora actual y la alarma activada, o deriva al estado de hora inválida si no es válida
+static mef_state_t DrawCurrentTime(mef_t self, mef_state_t next);
+
+//! Acción de entrada de los estados de ajuste: hace parpadear los dígitos del campo que se ajusta
+static mef_state_t DrawAdjusting(mef_t self, mef_state_t next);
+
+//! Función de salida de los estados de ajuste: detiene el parpadeo de los dígitos
+static void StopFlashing(mef_t self);
+
+//! Acción que comienza el ajuste de la hora a partir de la hora actual
+static mef_state_t StartTimeAdjust(mef_t self, mef_state_t next);
+
+//! Acción que comienza el ajuste de la alarma a partir de la alarma confirmada
+static mef_state_t StartAlarmAdjust(mef_t self, mef_state_t next);
+
+//! Acción de la tecla "accept" al mostrar la hora: pospone la alarma si suena, o si no la activa
+static mef_state_t AcceptAlarm(mef_t self, mef_state_t next);
+
+//! Acción de la tecla "cancel" al mostrar la hora: cancela la alarma si suena, o si no la desactiva
+static mef_state_t CancelAlarm(mef_t self, mef_state_t next);
+
+//! Acción que incrementa el campo del estado actual
+static mef_state_t Increment(mef_t self, mef_state_t next);
+
+//! Acción que decrementa el campo del estado actual
+static mef_state_t Decrement(mef_t self, mef_state_t next);
+
+/**
+ * @brief Función que modifica el campo del estado actual en el reloj y muestra el resultado
+ *
+ * @param self Contexto de la MEF
+ * @param direction Sentido del cambio: 1 para incrementar o -1 para decrementar
+ */
+static void AdjustField(mef_t self, int16_t direction);
+
+//! Acción que descarta el ajuste de la hora y vuelve a la hora leída al comenzar el ajuste
+static mef_state_t RestoreTime(mef_t self, mef_state_t next);
+
+//! Acción que descarta el ajuste de la alarma y vuelve a la alarma confirmada
+static mef_state_t RestoreAlarm(mef_t self, mef_state_t next);
+
+//! Acción que confirma la alarma ajustada y la activa
+static mef_state_t ConfirmAlarm(mef_t self, mef_state_t next);
+
+/* === Private variable definitions ================================================================================ */
+
+//! Campos que se ajustan en los estados de ajuste. Un campo nuevo solo requiere un elemento aquí y una fila por estado
+static const struct mef_field_s FIELDS[] = {
+    {.alarm = false, .accelerated = true, .from = 2, .to = 3, .add = ClockAddMinutes, .shift = NULL},
+    {.alarm = false, .accelerated = false, .from = 0, .to = 1, .add = ClockAddHours, .shift = NULL},
+    {.alarm = true, .accelerated = true, .from = 2, .to = 3, .add = NULL, .shift = ClockTimeAddMinutes},
+    {.alarm = true, .accelerated = false, .from = 0, .to = 1, .add = NULL, .shift = ClockTimeAddHours},
+};
+
+//! Descripción de cada estado de la MEF
+static const mef_state_info_t STATES[MEF_STATE_COUNT] = {
+    [MEF_STATE_INVALID_TIME] = {.entry = DrawInvalidTime, .exit = NULL, .field = NULL},
+    [MEF_STATE_SHOWING_CURRENT_TIME] = {.entry = DrawCurrentTime, .exit = NULL, .field = NULL},
+    [MEF_STATE_ADJUSTING_TIME_MINUTES] = {.entry = DrawAdjusting, .exit = StopFlashing, .field = &FIELDS[0]},
+    [MEF_STATE_ADJUSTING_TIME_HOURS] = {.entry = DrawAdjusting, .exit = StopFlashing, .field = &FIELDS[1]},
+    [MEF_STATE_ADJUSTING_ALARM_MINUTES] = {.entry = DrawAdjusting, .exit = StopFlashing, .field = &FIELDS[2]},
+    [MEF_STATE_ADJUSTING_ALARM_HOURS] = {.entry = DrawAdjusting, .exit = StopFlashing, .field = &FIELDS[3]},
+};
+
+/**
+ * @brief Tabla de transiciones de la MEF, indexada por estado y por entrada
+ *
+ * NOTA: Cada fila indica solo las entradas que el estado atiende. Las demás quedan en cero, es decir sin acción y con
+ * MEF_STATE_UNCHANGED como estado siguiente, por lo que no hacen nada
+ */
+static const mef_transition_t TRANSITIONS[MEF_STATE_COUNT][MEF_INPUT_COUNT] = {
+    [MEF_STATE_INVALID_TIME] =
+        {
+            [MEF_INPUT_SET_TIME] = {StartTimeAdjust, MEF_STATE_ADJUSTING_TIME_MINUTES},
+            [MEF_INPUT_CLOCK_MINUTE] = {DrawInvalidTime, MEF_STATE_UNCHANGED},
+        },
+    [MEF_STATE_SHOWING_CURRENT_TIME] =
+        {
+            [MEF_INPUT_SET_TIME] = {StartTimeAdjust, MEF_STATE_ADJUSTING_TIME_MINUTES},
+            [MEF_INPUT_SET_ALARM] = {StartAlarmAdjust, MEF_STATE_ADJUSTING_ALARM_MINUTES},
+            [MEF_INPUT_ACCEPT] = {AcceptAlarm, MEF_STATE_UNCHANGED},
+            [MEF_INPUT_CANCEL] = {CancelAlarm, MEF_STATE_UNCHANGED},
+            [MEF_INPUT_CLOCK_MINUTE] = {DrawCurrentTime, MEF_STATE_UNCHANGED},
+        },
+    [MEF_STATE_ADJUSTING_TIME_MINUTES] =
+        {
+            [MEF_INPUT_INCREMENT] = {Increment, MEF_STATE_UNCHANGED},
+            [MEF_INPUT_DECREMENT] = {Decrement, MEF_STATE_UNCHANGED},
+            [MEF_INPUT_ACCEPT] = {NULL, MEF_STATE_ADJUSTING_TIME_HOURS},
+            [MEF_INPUT_CANCEL] = {RestoreTime, MEF_STATE_SHOWING_CURRENT_TIME},
+            [MEF_INPUT_TIMEOUT] = {RestoreTime, MEF_STATE_SHOWING_CURRENT_TIME},
+        },
+    [MEF_STATE_ADJUSTING_TIME_HOURS] =
+        {
+            [MEF_INPUT_INCREMENT] = {Increment, MEF_STATE_UNCHANGED},
+            [MEF_INPUT_DECREMENT] = {Decrement, MEF_STATE_UNCHANGED},
+            [MEF_INPUT_ACCEPT] = {NULL, MEF_STATE_SHOWING_CURRENT_TIME},
+            [MEF_INPUT_CANCEL] = {RestoreTime, MEF_STATE_SHOWING_CURRENT_TIME},
+            [MEF_INPUT_TIMEOUT] = {RestoreTime, MEF_STATE_SHOWING_CURRENT_TIME},
+        },
+    [MEF_STATE_ADJUSTING_ALARM_MINUTES] =
+        {
+            [MEF_INPUT_INCREMENT] = {Increment, MEF_STATE_UNCHANGED},
+            [MEF_INPUT_DECREMENT] = {Decrement, MEF_STATE_UNCHANGED},
+            [MEF_INPUT_ACCEPT] = {NULL, MEF_STATE_ADJUSTING_ALARM_HOURS},
+            [MEF_INPUT_CANCEL] = {RestoreAlarm, MEF_STATE_SHOWING_CURRENT_TIME},
+            [MEF_INPUT_TIMEOUT] = {RestoreAlarm, MEF_STATE_SHOWING_CURRENT_TIME},
+        },
+    [MEF_STATE_ADJUSTING_ALARM_HOURS] =
+        {
+            [MEF_INPUT_INCREMENT] = {Increment, MEF_STATE_UNCHANGED},
+            [MEF_INPUT_DECREMENT] = {Decrement, MEF_STATE_UNCHANGED},
+            [MEF_INPUT_ACCEPT] = {ConfirmAlarm, MEF_STATE_SHOWING_CURRENT_TIME},
+            [MEF_INPUT_CANCEL] = {RestoreAlarm, MEF_STATE_SHOWING_CURRENT_TIME},
+            [MEF_INPUT_TIMEOUT] = {RestoreAlarm, MEF_STATE_SHOWING_CURRENT_TIME},
+        },
+};
+
+/* === Public variable definitions ================================================================================= */
+
+/* === Private function definitions ================================================================================ */
+
+static mef_t MEFInit(mef_t self, clock_t clock, screen_t screen, uint32_t timeout) {
+    if (self != NULL) {
+        memset(self, 0, sizeof(struct mef_s));
+        self->clock = clock;
+        self->screen = screen;
+        for (uint8_t state = 0; state < MEF_STATE_COUNT; state++) {
+            self->timeouts[state] = timeout;
+        }
+        self->armed_timeout = MEF_NO_TIMEOUT;
+        self->state = MEF_STATE_SHOWING_CURRENT_TIME;
+        self->step = 1;
+    }
+
+    return self;
+}
+
+static void ArmDeadline(mef_t self, uint32_t now) {
+    const mef_transition_t* transition = &TRANSITIONS[self->state][MEF_INPUT_TIMEOUT];
+
+    self->armed_at = now;
+    if ((transition->action != NULL) || (transition->next != MEF_STATE_UNCHANGED)) {
+        self->armed_timeout = self->timeouts[self->state];
+    } else {
+        self->armed_timeout = MEF_NO_TIMEOUT;
+    }
+}
+
+static void Dispatch(mef_t self, mef_input_t input, uint32_t now) {
+    const mef_transition_t* transition = &TRANSITIONS[self->state][input];
+    mef_state_t next = (mef_state_t)transition->next;
+    bool handled = (transition->action != NULL) || (next != MEF_STATE_UNCHANGED);
+
+    if (transition->action != NULL) {
+        next = transition->action(self, next);
+    }
+    if (next == MEF_STATE_UNCHANGED) {
+        next = self->state;
+    }
+
+    // El plazo se vuelve a armar al cambiar de estado o al atender una pulsación, pero no al cumplirse: es de un solo
+    // disparo, por lo que entre dos pulsaciones la MEF recibe a lo sumo un MEF_INPUT_TIMEOUT
+    if ((next != self->state) || (handled && (input != MEF_INPUT_TIMEOUT))) {
+        ChangeState(self, next);
+        ArmDeadline(self, now);
+    }
+}
+
+static void ChangeState(mef_t self, mef_state_t next) {
+    while (next != self->state) {
+        if (STATES[self->state].exit != NULL) {
+            STATES[self->state].exit(self);
+        }
+        self->state = next;
+        next = STATES[next].entry(self, next);
+    }
+}
+
+static mef_state_t DrawInvalidTime(mef_t self, mef_state_t next) {
+    ScreenWriteBCD(self->screen, self->current_time.bcd, 4);
+    ScreenFlashDigits(self->screen, 0, 3, MEF_FLASH_HALF_PERIOD);
+
+    ScreenSetDotState(self->screen, 2, true);
+    ScreenFlashDot(self->screen, 2, MEF_FLASH_HALF_PERIOD);
+
+    return next;
+}
+
+static mef_state_t DrawCurrentTime(mef_t self, mef_state_t next) {
+    self->valid_time = ClockGetTime(self->clock, &self->current_time);
+
+    if (self->valid_time) {
+        ScreenWriteBCD(self->screen, self->current_time.bcd, 4);
+        ScreenFlashDigits(self->screen, 0, 3, 0);
+
+        ScreenSetDotState(self->screen, 2, true);
+        ScreenFlashDot(self->screen, 2, MEF_FLASH_HALF_PERIOD);
+
+        if (ClockGetIfAlarmIsActivated(self->clock)) {
+            ScreenSetDotState(self->screen, 0, true);
+        }
+    } else {
+        next = MEF_STATE_INVALID_TIME;
+    }
+
+    return next;
+}
+
+static mef_state_t DrawAdjusting(mef_t self, mef_state_t next) {
+    mef_field_t field = STATES[self->state].field;
+
+    ScreenFlashDot(self->screen, 2, 0);
+
+    if (field->alarm) {
+        ClockGetAlarm(self->clock, &self->adjusted_alarm_time);
+        ScreenWriteBCD(self->screen, self->adjusted_alarm_time.bcd, 4);
+        for (uint8_t dot = 0; dot < 4; dot++) {
+            ScreenSetDotState(self->screen, dot, true);
+        }
+    }
+    ScreenFlashDigits(self->screen, field->from, field->to, MEF_FLASH_HALF_PERIOD);
+
+    return next;
+}
+
+static void StopFlashing(mef_t self) {
+    ScreenFlashDigits(self->screen, 0, 3, 0);
+}
+
+static mef_state_t StartTimeAdjust(mef_t self, mef_state_t next) {
+    // La hora mostrada puede tener hasta un minuto de antigüedad, por lo que se lee la hora actual
+    if (self->state == MEF_STATE_SHOWING_CURRENT_TIME) {
+        self->valid_time = ClockGetTime(self->clock, &self->current_time);
+    }
+    self->adjusted_time = self->current_time;
+
+    return next;
+}
+
+static mef_state_t StartAlarmAdjust(mef_t self, mef_state_t next) {
+    self->adjusted_alarm_time = self->alarm_time;
+
+    return next;
+}
+
+static mef_state_t AcceptAlarm(mef_t self, mef_state_t next) {
+    if (ClockGetIfAlarmIsRinging(self->clock)) {
+        ClockSnoozeAlarm(self->clock);
+    } else {
+        self->alarm_is_activated = true;
+        ClockSetAlarm(self->clock, &self->alarm_time);
+        next = DrawCurrentTime(self, next);
+    }
+
+    return next;
+}
+
+static mef_state_t CancelAlarm(mef_t self, mef_state_t next) {
+    if (ClockGetIfAlarmIsRinging(self->clock)) {
+        ClockCancelAlarm(self->clock);
+    } else {
+        self->alarm_is_activated = false;
+        ClockDisableAlarm(self->clock);
+        next = DrawCurrentTime(self, next);
+    }
+
+    return next;
+}
+
+static mef_state_t Increment(mef_t self, mef_state_t next) {
+    AdjustField(self, 1);
+
+    return next;
+}
+
+static mef_state_t Decrement(mef_t self, mef_state_t next) {
+    AdjustField(self, -1);
+
+    return next;
+}
+
+static void AdjustField(mef_t self, int16_t direction) {
+    mef_field_t field = STATES[self->state].field;
+    // Al mantener "increment" o "decrement" la repetición se acelera y puede avanzar varios minutos por evento.
+    // Las horas avanzan siempre de a una, porque un salto de varias horas recorre el día demasiado rápido
+    int16_t units = direction * (field->accelerated ? self->step : 1);
+
+    if (field->alarm) {
+        // La alarma ajustada se calcula sin pasar por el reloj, que solo se entera al confirmar el ajuste. Mientras
+        // tanto la alarma queda desactivada, para que no suene una hora que el usuario está cambiando
+        field->shift(&self->adjusted_alarm_time, units, &self->adjusted_alarm_time);
+        if (ClockGetIfAlarmIsActivated(self->clock)) {
+            ClockDisableAlarm(self->clock);
+        }
+
+        ScreenWriteBCD(self->screen, self->adjusted_alarm_time.bcd, 4);
+    } else {
+        // Se vuelve a la hora ajustada antes de sumar todo el paso de una vez, para que el tiempo transcurrido desde el
+        // evento anterior no se acumule en la hora que se está ajustando
+        ClockSetTime(self->clock, &self->adjusted_time);
+        field->add(self->clock, units);
+        ClockGetTime(self->clock, &self->adjusted_time);
+
+        ScreenWriteBCD(self->screen, self->adjusted_time.bcd, 4);
+        ScreenSetDotState(self->screen, 2, true);
+    }
+}
+
+static mef_state_t RestoreTime(mef_t self, mef_state_t next) {
+    ClockSetTime(self->clock, &self->current_time);
+
+    return self->valid_time ? next : MEF_STATE_INVALID_TIME;
+}
+
+static mef_state_t RestoreAlarm(mef_t self, mef_state_t next) {
+    if (self->alarm_is_activated) {
+        ClockSetAlarm(self->clock, &self->alarm_time);
+    } else {
+        ClockDisableAlarm(self->clock);
+    }
+
+    return next;
+}
+
+static mef_state_t ConfirmAlarm(mef_t self, mef_state_t next) {
+    self->alarm_time = self->adjusted_alarm_time;
+    ClockSetAlarm(self->clock, &self->alarm_time);
+    self->alarm_is_activated = true;
+
+    return next;
+}
+
+/* === Public function definitions ================================================================================= */
+
+#ifndef USE_STATIC_MEMORY
+mef_t MEFCreate(clock_t clock, screen_t screen, uint32_t timeout) {
+    return MEFInit(malloc(sizeof(struct mef_s)), clock, screen, timeout);
+}
+#endif
+
+mef_t MEFCreateStatic(mef_storage_t* storage, clock_t clock, screen_t screen, uint32_t timeout) {
+    return MEFInit((mef_t)storage, clock, screen, timeout);
+}
+
+void MEFStart(mef_t self, uint32_t now) {
+    if (self != NULL) {
+        self->state = MEF_STATE_SHOWING_CURRENT_TIME;
+        ChangeState(self, STATES[self->state].entry(self, self->state));
+        ArmDeadline(self, now);
+    }
+}
+
+void MEFStep(mef_t self, const mef_event_t* event, uint32_t now) {
+    if (self != NULL) {
+        // El tiempo sin pulsaciones se atiende antes que el evento, que pudo haber llegado luego de cumplirse
+        if (MEFGetTicksToTimeout(self, now) == 0) {
+            self->armed_timeout = MEF_NO_TIMEOUT;
+            Dispatch(self, MEF_INPUT_TIMEOUT, now);
+        }
+
+        self->step = event->step;
+        Dispatch(self, event->input, now);
+    }
+}
+
+uint32_t MEFGetTicksToTimeout(mef_t self, uint32_t now) {
+    uint32_t result = MEF_NO_TIMEOUT;
+    uint32_t elapsed;
+
+    if ((self != NULL) && (self->armed_timeout != MEF_NO_TIMEOUT)) {
+        elapsed = now - self->armed_at;
+        result = (elapsed < self->armed_timeout) ? (self->armed_timeout - elapsed) : 0;
+    }
+
+    return result;
+}
+
+void MEFSetTimeout(mef_t self, mef_state_t state, uint32_t timeout) {
+    if ((self != NULL) && (state < MEF_STATE_COUNT)) {
+        self->timeouts[state] = timeout;
+    }
+}
+
+mef_state_t MEFGetState(mef_t self) {
+    return (self != NULL) ? self->state : MEF_STATE_UNCHANGED;
+}
+
+/* === End of documentation ======================================================================================== */
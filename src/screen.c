@@ -27,15 +27,21 @@ SPDX-License-Identifier: MIT
 #include "FreeRTOS.h"
 #include "task.h"
 #include "screen.h"
-#include "bsp.h"
 #include <stdlib.h>
 #include <string.h>
 
 /* === Macros definitions ========================================================================================== */
 
-#ifndef SCREEN_MAX_DIGITS
-#define SCREEN_MAX_DIGITS 8
-#endif
+#define SCREEN_PHASE_RESTART 0xFFFFU //!< Valor de una cuenta de parpadeo que debe reiniciarse en el próximo cuadro
+#define SCREEN_NO_CHANGE     0xFFFFU //!< Cuadros programados cuando no parpadea nada (solo se recompila ante un cambio)
+
+//! Fracción encendida de un nivel de brillo, con corrección gamma aproximada por el promedio de x^2 y x^3 (gamma ~2,4)
+#define SCREEN_GAMMA(level)                                                                                                                                                                            \
+    ((uint16_t)(((uint32_t)SCREEN_DUTY_FULL * ((level) * (level) * (level) + (level) * (level) * SCREEN_BRIGHTNESS_MAX)) /                                                                             \
+                (2U * SCREEN_BRIGHTNESS_MAX * SCREEN_BRIGHTNESS_MAX * SCREEN_BRIGHTNESS_MAX)))
+
+//! Barrera que ordena la escritura de los datos de la pantalla antes de avisar que cambiaron
+#define SCREEN_MEMORY_BARRIER() __sync_synchronize()
 
 /* === Private data type declarations ============================================================================== */
 
@@ -43,18 +49,38 @@ SPDX-License-Identifier: MIT
 struct screen_s {
     uint8_t digits;                                  //!< Cantidad de digitos que tiene la pantalla
     uint8_t memory_video[SCREEN_MAX_DIGITS];         //!< Arreglo en el que cada elemento representa los segmentos (8 bits) de cada uno de los displays
+    uint8_t frame[SCREEN_MAX_DIGITS];                //!< Segmentos ya compilados (contenido y fase de parpadeo) que se envían a cada display
+    uint8_t brightness[SCREEN_MAX_DIGITS];           //!< Nivel de brillo de cada display
     uint8_t current_digit;                           //!< Digito actual que se está mostrando en la pantalla
     uint8_t flashing_from;                           //!< Digito desde el cual se produce el parapdeo (si es que parpadean los segmentos)
     uint8_t flashing_to;                             //!< Digito hasta el cual se produce el parapdeo (si es que parpadean los segmentos)
-    uint8_t flashing_count;                          //!< Cuenta la cantidad de ciclos que van pasando (si es que parpadean los segmentos)
+    volatile bool changed;                           //!< Indica que cambió el contenido o el parpadeo y hay que recompilar los cuadros
+    uint16_t frames_to_change;                       //!< Cuadros que faltan para el próximo cambio de fase de algún parpadeo
+    uint16_t frames_scheduled;                       //!< Cuadros que se programaron en la última compilación
+    uint16_t flashing_count;                         //!< Cuenta la cantidad de ciclos que van pasando (si es que parpadean los segmentos)
     uint16_t flashing_period;                        //!< Período del parpadeo de segmentos (Cantidad de ciclos totales entre que se enciende, se apaga y se vuelve a encender)
-    uint8_t flashing_dot_count[SCREEN_MAX_DIGITS];   //!< Cuenta la cantidad de ciclos que van pasando (si es que parpadean los puntos)
+    uint16_t flashing_dot_count[SCREEN_MAX_DIGITS];  //!< Cuenta la cantidad de ciclos que van pasando (si es que parpadean los puntos)
     uint16_t flashing_dot_period[SCREEN_MAX_DIGITS]; //!< Período del parpadeo de los puntos (Cantidad de ciclos totales entre que se enciende, se apaga y se vuelve a encender)
+    uint16_t frame_duty[SCREEN_MAX_DIGITS];          //!< Fracción ya compilada del intervalo en que se enciende cada display
+    uint16_t marquee_length;                         //!< Cantidad de dígitos del mensaje que se desplaza por la pantalla
+    uint16_t marquee_step;                           //!< Cuadros entre cada desplazamiento del mensaje
+    uint16_t marquee_count;                          //!< Cuadros que pasaron desde el último desplazamiento (SCREEN_PHASE_RESTART al comenzar)
+    uint16_t marquee_position;                       //!< Posición del mensaje: con 0 está a la derecha de la pantalla, todavía sin mostrarse
+    bool marquee_loop;                               //!< Indica si el mensaje vuelve a comenzar al terminar de pasar por la pantalla
+    volatile bool marquee_active;                    //!< Indica si se está desplazando un mensaje en lugar de mostrar la memoria de video
+    const uint8_t* marquee_glyphs;                   //!< Segmentos de cada dígito del mensaje (la memoria es de la aplicación)
+    screen_marquee_done_t marquee_done;              //!< Función que se llama al terminar un mensaje de una sola pasada (puede ser NULL)
+    void* marquee_context;                           //!< Contexto que recibe la función que avisa el final del mensaje
+    uint32_t generation;                             //!< Cantidad de actualizaciones que modificaron el contenido o el parpadeo
+    uint32_t elided;                                 //!< Cantidad de actualizaciones descartadas por no modificar nada
     screen_driver_t driver;                          //!< Driver de la pantalla con las funciones de callback
 };
 
-/*! Arreglo constante de 10 elementos en los que cada elemnto representa los segmentos correspondientes a cada número del 0 al 9 */
-static const uint8_t DIGIT_MAP[10] = {
+//! Falla al compilar si screen_storage_t no alcanza para alojar los datos internos de la pantalla
+typedef char screen_storage_size_check_t[(sizeof(screen_storage_t) >= sizeof(struct screen_s)) ? 1 : -1];
+
+/*! Arreglo constante de 16 elementos en los que cada elemnto representa los segmentos correspondientes a cada dígito hexadecimal */
+static const uint8_t DIGIT_MAP[16] = {
     SEGMENT_A | SEGMENT_B | SEGMENT_C | SEGMENT_D | SEGMENT_E | SEGMENT_F,             //!< Representa los segmentos del número "0"
     SEGMENT_B | SEGMENT_C,                                                             //!< Representa los segmentos del número "1"
     SEGMENT_A | SEGMENT_B | SEGMENT_D | SEGMENT_E | SEGMENT_G,                         //!< Representa los segmentos del número "2"
@@ -65,21 +91,155 @@ static const uint8_t DIGIT_MAP[10] = {
     SEGMENT_A | SEGMENT_B | SEGMENT_C,                                                 //!< Representa los segmentos del número "7"
     SEGMENT_A | SEGMENT_B | SEGMENT_C | SEGMENT_D | SEGMENT_E | SEGMENT_F | SEGMENT_G, //!< Representa los segmentos del número "8"
     SEGMENT_A | SEGMENT_B | SEGMENT_C | SEGMENT_D | SEGMENT_F | SEGMENT_G,             //!< Representa los segmentos del número "9"
+    SEGMENT_A | SEGMENT_B | SEGMENT_C | SEGMENT_E | SEGMENT_F | SEGMENT_G,             //!< Representa los segmentos del dígito hexadecimal "A"
+    SEGMENT_C | SEGMENT_D | SEGMENT_E | SEGMENT_F | SEGMENT_G,                         //!< Representa los segmentos del dígito hexadecimal "b"
+    SEGMENT_A | SEGMENT_D | SEGMENT_E | SEGMENT_F,                                     //!< Representa los segmentos del dígito hexadecimal "C"
+    SEGMENT_B | SEGMENT_C | SEGMENT_D | SEGMENT_E | SEGMENT_G,                         //!< Representa los segmentos del dígito hexadecimal "d"
+    SEGMENT_A | SEGMENT_D | SEGMENT_E | SEGMENT_F | SEGMENT_G,                         //!< Representa los segmentos del dígito hexadecimal "E"
+    SEGMENT_A | SEGMENT_E | SEGMENT_F | SEGMENT_G,                                     //!< Representa los segmentos del dígito hexadecimal "F"
+};
+
+/**
+ * @brief Arreglo constante con los segmentos de cada caracter ASCII que se puede representar en 7 segmentos
+ *
+ * NOTA: Las letras que solo tienen una forma (por ejemplo "b", "d" o "n") se muestran igual en mayúscula y minúscula.
+ * Los caracteres que no se pueden representar (como "K", "M", "V", "W" o "X") quedan en blanco
+ */
+static const uint8_t GLYPH_MAP[128] = {
+    ['.'] = SEGMENT_P,
+    ['-'] = SEGMENT_G,
+    ['_'] = SEGMENT_D,
+    ['='] = SEGMENT_D | SEGMENT_G,
+    ['0'] = SEGMENT_A | SEGMENT_B | SEGMENT_C | SEGMENT_D | SEGMENT_E | SEGMENT_F,
+    ['1'] = SEGMENT_B | SEGMENT_C,
+    ['2'] = SEGMENT_A | SEGMENT_B | SEGMENT_D | SEGMENT_E | SEGMENT_G,
+    ['3'] = SEGMENT_A | SEGMENT_B | SEGMENT_C | SEGMENT_D | SEGMENT_G,
+    ['4'] = SEGMENT_B | SEGMENT_C | SEGMENT_F | SEGMENT_G,
+    ['5'] = SEGMENT_A | SEGMENT_C | SEGMENT_D | SEGMENT_F | SEGMENT_G,
+    ['6'] = SEGMENT_A | SEGMENT_C | SEGMENT_D | SEGMENT_E | SEGMENT_F | SEGMENT_G,
+    ['7'] = SEGMENT_A | SEGMENT_B | SEGMENT_C,
+    ['8'] = SEGMENT_A | SEGMENT_B | SEGMENT_C | SEGMENT_D | SEGMENT_E | SEGMENT_F | SEGMENT_G,
+    ['9'] = SEGMENT_A | SEGMENT_B | SEGMENT_C | SEGMENT_D | SEGMENT_F | SEGMENT_G,
+    ['A'] = SEGMENT_A | SEGMENT_B | SEGMENT_C | SEGMENT_E | SEGMENT_F | SEGMENT_G,
+    ['a'] = SEGMENT_A | SEGMENT_B | SEGMENT_C | SEGMENT_E | SEGMENT_F | SEGMENT_G,
+    ['B'] = SEGMENT_C | SEGMENT_D | SEGMENT_E | SEGMENT_F | SEGMENT_G,
+    ['b'] = SEGMENT_C | SEGMENT_D | SEGMENT_E | SEGMENT_F | SEGMENT_G,
+    ['C'] = SEGMENT_A | SEGMENT_D | SEGMENT_E | SEGMENT_F,
+    ['c'] = SEGMENT_D | SEGMENT_E | SEGMENT_G,
+    ['D'] = SEGMENT_B | SEGMENT_C | SEGMENT_D | SEGMENT_E | SEGMENT_G,
+    ['d'] = SEGMENT_B | SEGMENT_C | SEGMENT_D | SEGMENT_E | SEGMENT_G,
+    ['E'] = SEGMENT_A | SEGMENT_D | SEGMENT_E | SEGMENT_F | SEGMENT_G,
+    ['e'] = SEGMENT_A | SEGMENT_D | SEGMENT_E | SEGMENT_F | SEGMENT_G,
+    ['F'] = SEGMENT_A | SEGMENT_E | SEGMENT_F | SEGMENT_G,
+    ['f'] = SEGMENT_A | SEGMENT_E | SEGMENT_F | SEGMENT_G,
+    ['G'] = SEGMENT_A | SEGMENT_C | SEGMENT_D | SEGMENT_E | SEGMENT_F,
+    ['g'] = SEGMENT_A | SEGMENT_B | SEGMENT_C | SEGMENT_D | SEGMENT_F | SEGMENT_G,
+    ['H'] = SEGMENT_B | SEGMENT_C | SEGMENT_E | SEGMENT_F | SEGMENT_G,
+    ['h'] = SEGMENT_C | SEGMENT_E | SEGMENT_F | SEGMENT_G,
+    ['I'] = SEGMENT_E | SEGMENT_F,
+    ['i'] = SEGMENT_E,
+    ['J'] = SEGMENT_B | SEGMENT_C | SEGMENT_D | SEGMENT_E,
+    ['j'] = SEGMENT_B | SEGMENT_C | SEGMENT_D | SEGMENT_E,
+    ['L'] = SEGMENT_D | SEGMENT_E | SEGMENT_F,
+    ['l'] = SEGMENT_D | SEGMENT_E | SEGMENT_F,
+    ['N'] = SEGMENT_C | SEGMENT_E | SEGMENT_G,
+    ['n'] = SEGMENT_C | SEGMENT_E | SEGMENT_G,
+    ['O'] = SEGMENT_A | SEGMENT_B | SEGMENT_C | SEGMENT_D | SEGMENT_E | SEGMENT_F,
+    ['o'] = SEGMENT_C | SEGMENT_D | SEGMENT_E | SEGMENT_G,
+    ['P'] = SEGMENT_A | SEGMENT_B | SEGMENT_E | SEGMENT_F | SEGMENT_G,
+    ['p'] = SEGMENT_A | SEGMENT_B | SEGMENT_E | SEGMENT_F | SEGMENT_G,
+    ['Q'] = SEGMENT_A | SEGMENT_B | SEGMENT_C | SEGMENT_F | SEGMENT_G,
+    ['q'] = SEGMENT_A | SEGMENT_B | SEGMENT_C | SEGMENT_F | SEGMENT_G,
+    ['R'] = SEGMENT_E | SEGMENT_G,
+    ['r'] = SEGMENT_E | SEGMENT_G,
+    ['S'] = SEGMENT_A | SEGMENT_C | SEGMENT_D | SEGMENT_F | SEGMENT_G,
+    ['s'] = SEGMENT_A | SEGMENT_C | SEGMENT_D | SEGMENT_F | SEGMENT_G,
+    ['T'] = SEGMENT_D | SEGMENT_E | SEGMENT_F | SEGMENT_G,
+    ['t'] = SEGMENT_D | SEGMENT_E | SEGMENT_F | SEGMENT_G,
+    ['U'] = SEGMENT_B | SEGMENT_C | SEGMENT_D | SEGMENT_E | SEGMENT_F,
+    ['u'] = SEGMENT_C | SEGMENT_D | SEGMENT_E,
+    ['Y'] = SEGMENT_B | SEGMENT_C | SEGMENT_D | SEGMENT_F | SEGMENT_G,
+    ['y'] = SEGMENT_B | SEGMENT_C | SEGMENT_D | SEGMENT_F | SEGMENT_G,
+    ['Z'] = SEGMENT_A | SEGMENT_B | SEGMENT_D | SEGMENT_E | SEGMENT_G,
+    ['z'] = SEGMENT_A | SEGMENT_B | SEGMENT_D | SEGMENT_E | SEGMENT_G,
+};
+
+#if SCREEN_BRIGHTNESS_LEVELS != 16
+#error "La tabla BRIGHTNESS_DUTY tiene un valor por cada uno de los 16 niveles de brillo"
+#endif
+
+//! Fracción del intervalo de un dígito (sobre SCREEN_DUTY_FULL) en que se enciende el display para cada nivel de brillo
+static const uint16_t BRIGHTNESS_DUTY[SCREEN_BRIGHTNESS_LEVELS] = {
+    SCREEN_GAMMA(0),  SCREEN_GAMMA(1),  SCREEN_GAMMA(2),  SCREEN_GAMMA(3),  SCREEN_GAMMA(4),  SCREEN_GAMMA(5),  SCREEN_GAMMA(6),  SCREEN_GAMMA(7),
+    SCREEN_GAMMA(8),  SCREEN_GAMMA(9),  SCREEN_GAMMA(10), SCREEN_GAMMA(11), SCREEN_GAMMA(12), SCREEN_GAMMA(13), SCREEN_GAMMA(14), SCREEN_GAMMA(15),
 };
 
 /* === Private function declarations =============================================================================== */
 
+/**
+ * @brief Función interna que inicializa los datos de una pantalla recién creada
+ *
+ * @param self Puntero a la memoria de la pantalla (puede ser NULL si no se pudo reservar)
+ * @param digits Cantidad de dígitos que tendrá la pantalla
+ * @param driver Driver con las funciones de callback de la pantalla
+ * @return screen_t El mismo puntero recibido
+ */
+static screen_t ScreenInit(screen_t self, uint8_t digits, screen_driver_t driver);
+
+/**
+ * @brief Función interna que registra una actualización aceptada y avisa a la función de refresco que debe recompilar
+ * los cuadros de la pantalla
+ *
+ * @param self Puntero a la estructura con los datos de la pantalla
+ */
+static void ScreenChanged(screen_t self);
+
+/**
+ * @brief Función interna que escribe los segmentos de los primeros dígitos y apaga los restantes, conservando sus puntos
+ *
+ * @param self Puntero a la estructura con los datos de la pantalla
+ * @param segments Segmentos de cada dígito a escribir, comenzando por el MSB
+ * @param size Cantidad de dígitos a escribir (como máximo la cantidad de dígitos de la pantalla)
+ */
+static void ScreenWriteSegments(screen_t self, const uint8_t segments[], uint8_t size);
+
+/**
+ * @brief Función interna que avanza la cuenta de un parpadeo en los cuadros que pasaron desde la última compilación
+ *
+ * @param count Puntero a la cuenta del parpadeo (SCREEN_PHASE_RESTART si se acaba de configurar)
+ * @param period Período del parpadeo, en cuadros (distinto de cero)
+ * @param elapsed Cuadros que pasaron desde la última compilación
+ * @return uint16_t Cuadros que faltan para que el parpadeo cambie de fase
+ */
+static uint16_t ScreenAdvancePhase(uint16_t* count, uint16_t period, uint16_t elapsed);
+
+/**
+ * @brief Función interna que compila el contenido y la fase de los parpadeos en los segmentos de cada display
+ *
+ * @param self Puntero a la estructura con los datos de la pantalla
+ *
+ * NOTA: Solo se ejecuta al comenzar un cuadro en el que cambia algo, y programa en cuántos cuadros debe repetirse
+ */
+static void ScreenCompile(screen_t self);
+
+/**
+ * @brief Función interna que avanza el mensaje que se desplaza en los cuadros que pasaron desde la última compilación
+ *
+ * @param self Puntero a la estructura con los datos de la pantalla
+ * @param elapsed Cuadros que pasaron desde la última compilación
+ * @return uint16_t Cuadros que faltan para el próximo desplazamiento (SCREEN_NO_CHANGE si no hay un mensaje activo)
+ *
+ * NOTA: Si un mensaje de una sola pasada termina de salir de la pantalla, se desactiva y se vuelve a la memoria de video
+ */
+static uint16_t ScreenAdvanceMarquee(screen_t self, uint16_t elapsed);
+
 /* === Private variable definitions ================================================================================ */
 
 /* === Public variable definitions ================================================================================= */
 
 /* === Private function definitions ================================================================================ */
 
-/* === Public function definitions ================================================================================= */
-
-screen_t ScreenCreate(uint8_t digits, screen_driver_t driver) {
-    screen_t self = malloc(sizeof(struct screen_s));
-
+static screen_t ScreenInit(screen_t self, uint8_t digits, screen_driver_t driver) {
     if (digits > SCREEN_MAX_DIGITS) {
         digits = SCREEN_MAX_DIGITS;
     }
@@ -88,10 +248,25 @@ screen_t ScreenCreate(uint8_t digits, screen_driver_t driver) {
         self->digits = digits;
         self->driver = driver;
         self->current_digit = 0;
+        self->flashing_from = 0;
+        self->flashing_to = 0;
         self->flashing_count = 0;
         self->flashing_period = 0;
-
-        for (int i = 0; i < self->digits; i++) {
+        self->frames_to_change = 1;
+        self->frames_scheduled = 1;
+        self->changed = true;
+        self->marquee_active = false;
+        self->marquee_glyphs = NULL;
+        self->marquee_done = NULL;
+        self->marquee_context = NULL;
+        self->generation = 0;
+        self->elided = 0;
+
+        for (int i = 0; i < SCREEN_MAX_DIGITS; i++) {
+            self->memory_video[i] = 0;
+            self->frame[i] = 0;
+            self->brightness[i] = SCREEN_BRIGHTNESS_MAX;
+            self->frame_duty[i] = SCREEN_DUTY_FULL;
             self->flashing_dot_count[i] = 0;
             self->flashing_dot_period[i] = 0;
         }
@@ -100,71 +275,239 @@ screen_t ScreenCreate(uint8_t digits, screen_driver_t driver) {
     return self;
 }
 
-void ScreenWriteBCD(screen_t self, uint8_t value[], uint8_t size) {
+static void ScreenChanged(screen_t self) {
+    self->generation = self->generation + 1;
+    SCREEN_MEMORY_BARRIER();
+    self->changed = true;
+}
 
-    for (int j = 0; j < self->digits; j++) {
-        self->memory_video[j] = self->memory_video[j] & SEGMENT_P_MASK;
-    }
+static void ScreenWriteSegments(screen_t self, const uint8_t segments[], uint8_t size) {
+    uint8_t memory;
+    bool changed = false;
 
-    if (size > self->digits) {
-        size = self->digits;
+    // Se compara antes de escribir, para descartar sin costo las escrituras que no cambian nada
+    for (int i = 0; i < self->digits; i++) {
+        memory = (i < size) ? segments[i] : (self->memory_video[i] & SEGMENT_P);
+        changed = changed || (memory != self->memory_video[i]);
     }
 
-    for (int i = 0; i < size; i++) {
-        self->memory_video[i] = DIGIT_MAP[value[i]];
+    if (changed) {
+        for (int i = 0; i < self->digits; i++) {
+            self->memory_video[i] = (i < size) ? segments[i] : (self->memory_video[i] & SEGMENT_P);
+        }
+        ScreenChanged(self);
+    } else {
+        self->elided = self->elided + 1;
     }
 }
 
-void ScreenRefresh(screen_t self) {
-
-    uint8_t segments;
-
-    self->driver->DigitsTurnOff();
+static uint16_t ScreenAdvancePhase(uint16_t* count, uint16_t period, uint16_t elapsed) {
+    uint16_t half = period / 2;
 
-    if (self->current_digit < self->digits - 1) {
-        self->current_digit = self->current_digit + 1;
+    // Igual que al contar cuadro a cuadro, el primer cuadro luego de configurar el parpadeo tiene la cuenta en uno
+    if (*count == SCREEN_PHASE_RESTART) {
+        *count = 1 % period;
     } else {
-        self->current_digit = 0;
+        *count = (uint16_t)(((uint32_t)*count + elapsed) % period);
     }
 
-    segments = self->memory_video[self->current_digit];
+    return (*count < half) ? (half - *count) : (period - *count);
+}
+
+static uint16_t ScreenAdvanceMarquee(screen_t self, uint16_t elapsed) {
+    uint32_t positions = (uint32_t)self->marquee_length + self->digits;
+    uint32_t position = 1;
+    uint32_t count = 0;
+    uint16_t next = SCREEN_NO_CHANGE;
+
+    if (self->marquee_active) {
+        // Al comenzar, el primer dígito del mensaje aparece de inmediato en el extremo derecho de la pantalla
+        if (self->marquee_count != SCREEN_PHASE_RESTART) {
+            count = (uint32_t)self->marquee_count + elapsed;
+            position = self->marquee_position + (count / self->marquee_step);
+            count = count % self->marquee_step;
+        }
 
-    // Parpadeo de los números (segmentos)
-    if (self->flashing_period != 0) {
-        if (self->current_digit == 0) {
-            self->flashing_count = (self->flashing_count + 1) % (self->flashing_period);
+        // Con todo el mensaje fuera de la pantalla termina una pasada; si se repite, comienza otra con la pantalla en blanco
+        if ((position >= positions) && self->marquee_loop) {
+            position = position % positions;
+        }
+
+        if (position >= positions) {
+            self->marquee_active = false;
+        } else {
+            self->marquee_position = (uint16_t)position;
+            self->marquee_count = (uint16_t)count;
+            next = self->marquee_step - self->marquee_count;
         }
+    }
+
+    return next;
+}
+
+static void ScreenCompile(screen_t self) {
+    uint16_t elapsed = self->frames_scheduled - self->frames_to_change;
+    uint16_t next = SCREEN_NO_CHANGE;
+    uint16_t frames;
+    int32_t glyph;
+    bool marquee = self->marquee_active;
+    bool scrolling;
+    uint8_t blank_from = SCREEN_MAX_DIGITS;
+    uint8_t blank_to = 0;
+    uint8_t segments;
+    bool dimmable = (self->driver != NULL) && (self->driver->DigitDim != NULL);
+
+    // Se baja el aviso antes de leer los datos, para no perder un cambio que ocurra durante la compilación
+    self->changed = false;
+    SCREEN_MEMORY_BARRIER();
 
+    next = ScreenAdvanceMarquee(self, elapsed);
+    scrolling = self->marquee_active;
+
+    if (self->flashing_period != 0) {
+        frames = ScreenAdvancePhase(&self->flashing_count, self->flashing_period, elapsed);
+        next = (frames < next) ? frames : next;
         if (self->flashing_count < (self->flashing_period / 2)) {
-            if (self->current_digit >= self->flashing_from) {
-                if (self->current_digit <= self->flashing_to) {
-                    segments = segments & SEGMENT_P_MASK;
-                }
-            }
+            blank_from = self->flashing_from;
+            blank_to = self->flashing_to;
         }
     }
 
-    // Parpadeo de los puntos
     for (int i = 0; i < self->digits; i++) {
+        // Mientras se desplaza un mensaje cada display muestra el dígito del mensaje que cae en la ventana de la pantalla
+        if (scrolling) {
+            glyph = (int32_t)self->marquee_position + i - self->digits;
+            segments = ((glyph >= 0) && (glyph < self->marquee_length)) ? self->marquee_glyphs[glyph] : SCREEN_GLYPH_BLANK;
+        } else {
+            segments = self->memory_video[i];
+        }
+
+        if ((i >= blank_from) && (i <= blank_to)) {
+            segments = segments & SEGMENT_P;
+        }
+
         if (self->flashing_dot_period[i] != 0) {
-            if (self->current_digit == 0) {
-                if (self->flashing_dot_count[i] < self->flashing_dot_period[i] - 1) {
-                    self->flashing_dot_count[i] = self->flashing_dot_count[i] + 1;
-                } else {
-                    self->flashing_dot_count[i] = 0;
-                }
+            frames = ScreenAdvancePhase(&self->flashing_dot_count[i], self->flashing_dot_period[i], elapsed);
+            next = (frames < next) ? frames : next;
+            if (self->flashing_dot_count[i] < (self->flashing_dot_period[i] / 2)) {
+                segments = segments & ~SEGMENT_P;
             }
+        }
+
+        // El nivel cero apaga los segmentos; sin la función DigitDim los demás niveles se muestran con el brillo máximo
+        if (self->brightness[i] == 0) {
+            segments = 0;
+        }
+
+        self->frame[i] = segments;
+        self->frame_duty[i] = dimmable ? BRIGHTNESS_DUTY[self->brightness[i]] : SCREEN_DUTY_FULL;
+    }
+
+    self->frames_scheduled = next;
+    self->frames_to_change = next;
+
+    if (marquee && !self->marquee_active && (self->marquee_done != NULL)) {
+        self->marquee_done(self->marquee_context);
+    }
+}
+
+/* === Public function definitions ================================================================================= */
+
+#ifndef USE_STATIC_MEMORY
+screen_t ScreenCreate(uint8_t digits, screen_driver_t driver) {
+    return ScreenInit(malloc(sizeof(struct screen_s)), digits, driver);
+}
+#endif
+
+screen_t ScreenCreateStatic(screen_storage_t* storage, uint8_t digits, screen_driver_t driver) {
+    return ScreenInit((screen_t)storage, digits, driver);
+}
+
+void ScreenWriteBCD(screen_t self, uint8_t value[], uint8_t size) {
+    uint8_t segments[SCREEN_MAX_DIGITS];
+
+    if (size > self->digits) {
+        size = self->digits;
+    }
+
+    // Los valores que no son un dígito hexadecimal se muestran en blanco, en lugar de leer fuera de la tabla
+    for (int i = 0; i < size; i++) {
+        segments[i] = (value[i] < sizeof(DIGIT_MAP)) ? DIGIT_MAP[value[i]] : SCREEN_GLYPH_BLANK;
+    }
+
+    ScreenWriteSegments(self, segments, size);
+}
 
-            if (self->flashing_dot_period[self->current_digit] != 0) {
-                if (self->flashing_dot_count[self->current_digit] < self->flashing_dot_period[self->current_digit] / 2) {
-                    segments = segments & (~SEGMENT_P_MASK);
-                }
+void ScreenWriteGlyphs(screen_t self, const uint8_t glyphs[], uint8_t size) {
+    if (self != NULL) {
+        if (size > self->digits) {
+            size = self->digits;
+        }
+        ScreenWriteSegments(self, glyphs, size);
+    }
+}
+
+int ScreenWriteText(screen_t self, const char* text) {
+    uint8_t glyphs[SCREEN_MAX_DIGITS];
+    uint8_t size;
+    int result = -1;
+
+    if ((self != NULL) && (text != NULL)) {
+        size = ScreenTextToGlyphs(text, glyphs, self->digits);
+        ScreenWriteSegments(self, glyphs, (size < self->digits) ? size : self->digits);
+        result = (size <= self->digits) ? 0 : -1;
+    }
+
+    return result;
+}
+
+uint16_t ScreenTextToGlyphs(const char* text, uint8_t glyphs[], uint16_t size) {
+    uint16_t count = 0;
+    bool takes_dot = false;
+    uint8_t character;
+
+    for (; (text != NULL) && (*text != '\0'); text++) {
+        character = (uint8_t)*text;
+
+        // El punto se agrega al caracter anterior, salvo al comienzo o luego de otro punto, donde ocupa un dígito
+        if ((character == '.') && takes_dot) {
+            if (count <= size) {
+                glyphs[count - 1] = glyphs[count - 1] | SEGMENT_P;
+            }
+            takes_dot = false;
+        } else {
+            if (count < size) {
+                glyphs[count] = (character < sizeof(GLYPH_MAP)) ? GLYPH_MAP[character] : SCREEN_GLYPH_BLANK;
             }
+            takes_dot = (character != '.');
+            count++;
         }
     }
 
-    self->driver->SegmentsUpdate(segments);
+    return count;
+}
+
+void ScreenRefresh(screen_t self) {
+    self->driver->DigitsTurnOff();
+
+    if (self->current_digit < self->digits - 1) {
+        self->current_digit = self->current_digit + 1;
+    } else {
+        self->current_digit = 0;
+
+        // Al comenzar cada cuadro solo se recompila si cambió algo o si algún parpadeo cambia de fase
+        self->frames_to_change = self->frames_to_change - 1;
+        if (self->changed || (self->frames_to_change == 0)) {
+            ScreenCompile(self);
+        }
+    }
+
+    self->driver->SegmentsUpdate(self->frame[self->current_digit]);
     self->driver->DigitTurnOn(self->current_digit);
+
+    if (self->frame_duty[self->current_digit] != SCREEN_DUTY_FULL) {
+        self->driver->DigitDim(self->frame_duty[self->current_digit]);
+    }
 }
 
 int ScreenFlashDigits(screen_t self, uint8_t from, uint8_t to, uint16_t half_period) {
@@ -184,7 +527,10 @@ int ScreenFlashDigits(screen_t self, uint8_t from, uint8_t to, uint16_t half_per
             self->flashing_from = from;
             self->flashing_to = to;
             self->flashing_period = new_period;
-            self->flashing_count = 0;
+            self->flashing_count = SCREEN_PHASE_RESTART;
+            ScreenChanged(self);
+        } else {
+            self->elided = self->elided + 1;
         }
     }
 
@@ -198,10 +544,20 @@ void ScreenSetDotState(screen_t self, uint8_t digit, bool turn_on) {
     }
 
     if (self != NULL) {
+        uint8_t i = (self->digits - 1) - digit;
+        uint8_t segments;
+
         if (turn_on == true) {
-            self->memory_video[(self->digits - 1) - digit] = self->memory_video[(self->digits - 1) - digit] | SEGMENT_P_MASK;
-        } else if (turn_on == false) {
-            self->memory_video[(self->digits - 1) - digit] = self->memory_video[(self->digits - 1) - digit] & (~SEGMENT_P_MASK);
+            segments = self->memory_video[i] | SEGMENT_P;
+        } else {
+            segments = self->memory_video[i] & (~SEGMENT_P);
+        }
+
+        if (segments != self->memory_video[i]) {
+            self->memory_video[i] = segments;
+            ScreenChanged(self);
+        } else {
+            self->elided = self->elided + 1;
         }
     }
 }
@@ -221,13 +577,122 @@ int ScreenFlashDot(screen_t self, uint8_t digit, uint16_t half_period) {
         // Solo cambiar si es distinto para evitar reiniciar el parpadeo
         if (self->flashing_dot_period[i] != new_period) {
             self->flashing_dot_period[i] = new_period;
-            self->flashing_dot_count[i] = 0;
+            self->flashing_dot_count[i] = SCREEN_PHASE_RESTART;
+            ScreenChanged(self);
+        } else {
+            self->elided = self->elided + 1;
+        }
+    }
+
+    return result;
+}
+
+int ScreenSetBrightness(screen_t self, uint8_t level) {
+    int result = 0;
+    bool changed = false;
+
+    if ((self == NULL) || (level > SCREEN_BRIGHTNESS_MAX)) {
+        result = -1;
+    } else {
+        for (int i = 0; i < self->digits; i++) {
+            changed = changed || (self->brightness[i] != level);
+            self->brightness[i] = level;
+        }
+
+        if (changed) {
+            ScreenChanged(self);
+        } else {
+            self->elided = self->elided + 1;
         }
     }
 
     return result;
 }
 
+int ScreenSetDigitBrightness(screen_t self, uint8_t digit, uint8_t level) {
+    int result = 0;
+
+    if ((self == NULL) || (digit >= self->digits) || (level > SCREEN_BRIGHTNESS_MAX)) {
+        result = -1;
+    } else if (self->brightness[(self->digits - 1) - digit] != level) {
+        self->brightness[(self->digits - 1) - digit] = level;
+        ScreenChanged(self);
+    } else {
+        self->elided = self->elided + 1;
+    }
+
+    return result;
+}
+
+int ScreenMarqueeStart(screen_t self, const uint8_t glyphs[], uint16_t length, uint16_t step, screen_marquee_mode_t mode) {
+    int result = -1;
+
+    if ((self != NULL) && (glyphs != NULL) && (length != 0) && (length <= SCREEN_MARQUEE_MAX_LENGTH) && (step != 0)) {
+        // Se desactiva antes de cambiar el mensaje, para que el refresco nunca combine datos de dos mensajes
+        self->marquee_active = false;
+        SCREEN_MEMORY_BARRIER();
+
+        self->marquee_glyphs = glyphs;
+        self->marquee_length = length;
+        self->marquee_step = step;
+        self->marquee_loop = (mode == SCREEN_MARQUEE_LOOP);
+        self->marquee_count = SCREEN_PHASE_RESTART;
+        self->marquee_position = 0;
+
+        SCREEN_MEMORY_BARRIER();
+        self->marquee_active = true;
+        ScreenChanged(self);
+        result = 0;
+    }
+
+    return result;
+}
+
+void ScreenMarqueeStop(screen_t self) {
+    if (self != NULL) {
+        if (self->marquee_active) {
+            self->marquee_active = false;
+            ScreenChanged(self);
+        } else {
+            self->elided = self->elided + 1;
+        }
+    }
+}
+
+bool ScreenMarqueeIsRunning(screen_t self) {
+    return (self != NULL) && self->marquee_active;
+}
+
+void ScreenSetMarqueeSink(screen_t self, screen_marquee_done_t done, void* context) {
+    if (self != NULL) {
+        self->marquee_done = NULL;
+        SCREEN_MEMORY_BARRIER();
+        self->marquee_context = context;
+        SCREEN_MEMORY_BARRIER();
+        self->marquee_done = done;
+    }
+}
+
+uint32_t ScreenGetGeneration(screen_t self) {
+    return (self != NULL) ? self->generation : 0;
+}
+
+void ScreenGetStats(screen_t self, screen_stats_t* stats) {
+    stats->accepted = 0;
+    stats->elided = 0;
+
+    if (self != NULL) {
+        stats->accepted = self->generation;
+        stats->elided = self->elided;
+    }
+}
+
+void ScreenRefreshFromISR(void* screen) {
+    if (screen != NULL) {
+        ScreenRefresh((screen_t)screen);
+    }
+}
+
 void ScreenRefreshTask(void* screen) {
 
     TickType_t last_value = xTaskGetTickCount();
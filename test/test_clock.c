@@ -82,6 +82,40 @@ SPDX-License-Identifier: MIT
  ** - 59) Probar que la alarma se puede posponder 2 veces
  ** - 60) Probar que se puede apagar la alarma, sin deshabilitarla, para que suene el día siguiente (Mediante la señal "Cancelar" si es que está sonando)
  ** - 61) Probar que si se pospuso la alarma un determinado tiempo, pasado un día vuelve a sonar a la hora seteada inicialmente
+ ** - 62) Probar que no se puede setear una hora cuyos dígitos no son valores BCD válidos
+ ** - 63) Probar que se pueden sumar segundos a una hora, pasando de 23:59:59 a 00:00:00
+ ** - 64) Probar que se pueden restar segundos a una hora, pasando de 00:00:00 a 23:59:59
+ ** - 65) Probar que sumar varias horas o días de segundos se calcula correctamente
+ ** - 66) Probar que no se pueden sumar segundos a una hora inválida
+ ** - 67) Probar que la alarma pospuesta cerca de la medianoche vuelve a sonar al día siguiente
+ ** - 68) Probar que, con una base de tiempo libre, la hora avanza sin llamar a ClockTick()
+ ** - 69) Probar que se puede saber cuántos ticks faltan para la próxima alarma
+ ** - 70) Probar que, con una base de tiempo libre, la alarma suena al sincronizar el reloj en el instante calculado
+ ** - 71) Probar que la base de tiempo libre puede desbordar sin afectar a la hora
+ ** - 72) Probar que la alarma suena en el mismo segundo en que la hora actual alcanza la hora de la alarma
+ ** - 73) Probar que la alarma suena si un ajuste de la hora salta hacia adelante por encima de la hora de la alarma
+ ** - 74) Probar que la alarma no suena si el ajuste de la hora es hacia atrás o salta demasiado hacia adelante
+ ** - 75) Probar que las alarmas suenan en orden cronológico sin importar el orden en el que se setearon
+ ** - 76) Probar que el orden de las alarmas tiene en cuenta el paso de 23:59:59 a 00:00:00
+ ** - 77) Probar que dos alarmas seteadas a la misma hora suenan en el mismo segundo y se pueden posponer por separado
+ ** - 78) Probar que no se puede setear una alarma con un número de alarma fuera de la tabla
+ ** - 79) Probar que se puede avanzar el reloj una cantidad arbitraria de ticks de una sola vez
+ ** - 80) Probar que al avanzar el reloj de una sola vez suenan en orden las alarmas del intervalo salteado
+ ** - 81) Probar que al avanzar el reloj de una sola vez suena la alarma pospuesta
+ ** - 82) Probar que se puede avanzar el reloj un año completo y la alarma queda sonando
+ ** - 83) Probar que se notifica cada cambio de segundo y cada cambio de minuto
+ ** - 84) Probar que se notifica cuando suena una alarma y cuando vence su posposición
+ ** - 85) Probar que solo se notifican los eventos suscriptos y que se puede dejar de notificar
+ ** - 86) Probar que al avanzar el reloj de una sola vez todos los eventos se entregan en una única notificación
+ ** - 87) Probar que se puede crear un reloj en una memoria reservada por la aplicación y que funciona normalmente
+ ** - 88) Probar que no se crea el reloj si no se indica la memoria donde crearlo
+ ** - 89) Probar que si otra tarea sincroniza el reloj en medio de una modificación, los ticks no se aplican dos veces
+ **       y la agenda de alarmas queda consistente
+ ** - 90) Probar que se pueden sumar y restar varios minutos de una vez, sin modificar las horas
+ ** - 91) Probar que se pueden sumar y restar varias horas de una vez, pasando por la medianoche
+ ** - 92) Probar que sumar varios minutos u horas de una vez sincroniza el reloj una sola vez
+ ** - 93) Probar que se pueden calcular los minutos y las horas sumados a otra hora, sin modificar el reloj
+ ** - 94) Probar que si se cancela la alarma, al día siguiente se notifica como una alarma nueva y no como una posposición
  **/
 
 /* === Headers files inclusions ==================================================================================== */
@@ -133,8 +167,74 @@ static void ClockAlarmTurnOn(void);
  */
 static void ClockAlarmTurnOff(void);
 
+/**
+ * @brief Función que simula una base de tiempo libre para el reloj
+ *
+ * @return uint32_t Cuenta actual de ticks de la base de tiempo simulada
+ */
+static uint32_t FakeTickSource(void);
+
+/**
+ * @brief Función que simula una base de tiempo libre durante cuya lectura otra tarea sincroniza el reloj
+ *
+ * @return uint32_t Cuenta de ticks de la base de tiempo simulada al momento de la lectura
+ *
+ * NOTA: Si "preempt_sync" está activo, luego de leer la cuenta simula que la tarea del temporizador interrumpe a la
+ * que está leyendo, un tick más tarde, y sincroniza el reloj antes de que la lectura se utilice
+ */
+static uint32_t PreemptedTickSource(void);
+
+/**
+ * @brief Función que simula la recepción de las notificaciones de eventos del reloj
+ *
+ * @param context Contexto registrado junto con la función
+ * @param events Máscara con los eventos notificados
+ */
+static void FakeNotify(void* context, uint32_t events);
+
+/**
+ * @brief Función que simula el encendido del sonido de la primera alarma, registrando el orden en que suena
+ */
+static void FirstAlarmTurnOn(void);
+
+/**
+ * @brief Función que simula el encendido del sonido de la segunda alarma, registrando el orden en que suena
+ */
+static void SecondAlarmTurnOn(void);
+
+/**
+ * @brief Función que simula la base de tiempo contando la cantidad de veces que el reloj la lee
+ *
+ * @return uint32_t Cuenta de ticks simulada
+ */
+static uint32_t CountingTickSource(void);
+
 /* === Private variable definitions ================================================================================ */
 
+//! Cuenta de ticks de la base de tiempo simulada
+static uint32_t fake_ticks;
+
+//! Cantidad de veces que el reloj leyó la base de tiempo simulada con CountingTickSource()
+static uint16_t source_reads;
+
+//! Indica que la próxima lectura de la base de tiempo debe simular una sincronización de otra tarea
+static bool preempt_sync;
+
+//! Registro del orden en el que sonaron las alarmas con driver propio
+static uint8_t ringing_log[4];
+
+//! Cantidad de entradas en el registro de alarmas que sonaron
+static uint8_t ringing_count;
+
+//! Eventos recibidos por la función de notificación simulada
+static uint32_t notified_events;
+
+//! Cantidad de notificaciones recibidas por la función de notificación simulada
+static uint32_t notify_count;
+
+//! Contexto recibido en la última notificación
+static void* notified_context;
+
 /* === Public variable definitions ================================================================================= */
 
 //! Variable global que representa al reloj
@@ -146,6 +246,18 @@ static const struct clock_alarm_driver_s driver = {
     .ClockAlarmTurnOff = ClockAlarmTurnOff,
 };
 
+//! Driver de la primera alarma con registro del orden en el que suena
+static const struct clock_alarm_driver_s first_driver = {
+    .ClockAlarmTurnOn = FirstAlarmTurnOn,
+    .ClockAlarmTurnOff = ClockAlarmTurnOff,
+};
+
+//! Driver de la segunda alarma con registro del orden en el que suena
+static const struct clock_alarm_driver_s second_driver = {
+    .ClockAlarmTurnOn = SecondAlarmTurnOn,
+    .ClockAlarmTurnOff = ClockAlarmTurnOff,
+};
+
 /* === Private function definitions ================================================================================ */
 
 void setUp(void) {
@@ -153,7 +265,7 @@ void setUp(void) {
 }
 
 void SimulateNSeconds(clock_t self, uint32_t seconds) {
-    for (uint8_t i = 0; i < CLOCK_TICKS_PER_SECOND * seconds; i++) {
+    for (uint32_t i = 0; i < CLOCK_TICKS_PER_SECOND * seconds; i++) {
         ClockTick(self);
     }
 }
@@ -164,6 +276,48 @@ static void ClockAlarmTurnOn(void) {
 static void ClockAlarmTurnOff(void) {
 }
 
+static void FakeNotify(void* context, uint32_t events) {
+    notified_context = context;
+    notified_events |= events;
+    notify_count++;
+}
+
+static void FirstAlarmTurnOn(void) {
+    if (ringing_count < sizeof(ringing_log)) {
+        ringing_log[ringing_count] = 1;
+        ringing_count++;
+    }
+}
+
+static void SecondAlarmTurnOn(void) {
+    if (ringing_count < sizeof(ringing_log)) {
+        ringing_log[ringing_count] = 2;
+        ringing_count++;
+    }
+}
+
+static uint32_t FakeTickSource(void) {
+    return fake_ticks;
+}
+
+static uint32_t PreemptedTickSource(void) {
+    uint32_t now = fake_ticks;
+
+    if (preempt_sync) {
+        preempt_sync = false;
+        fake_ticks += 1;
+        ClockSync(clock);
+    }
+
+    return now;
+}
+
+static uint32_t CountingTickSource(void) {
+    source_reads++;
+
+    return fake_ticks;
+}
+
 /* === Public function definitions ================================================================================= */
 
 // 1) Probar que el reloj, al iniciar, se encuentra en un estado inválido
@@ -1221,4 +1375,895 @@ void test_alarm_rings_at_setted_time_even_if_it_was_snoozed(void) {
     TEST_ASSERT_TRUE(ClockGetIfAlarmIsRinging(clock));
 }
 
+// 62) Probar que no se puede setear una hora cuyos dígitos no son valores BCD válidos
+void test_time_with_invalid_bcd_digits_can_not_be_set(void) {
+
+    static const clock_time_t new_time = {
+        .time.hours = {0, 15},
+        .time.minutes = {3, 0},
+        .time.seconds = {3, 0},
+    };
+
+    TEST_ASSERT_FALSE(ClockSetTime(clock, &new_time));
+    TEST_ASSERT_FALSE(ClockSetAlarm(clock, &new_time));
+}
+
+// 63) Probar que se pueden sumar segundos a una hora, pasando de 23:59:59 a 00:00:00
+void test_add_seconds_to_time_across_midnight(void) {
+
+    static const clock_time_t time = {
+        .time.hours = {2, 3},
+        .time.minutes = {5, 9},
+        .time.seconds = {5, 0},
+    };
+
+    clock_time_t new_time = {0};
+
+    TEST_ASSERT_TRUE(ClockTimeAddSeconds(&time, 15, &new_time));
+    TEST_ASSERT_TIME(0, 0, 0, 0, 0, 5, new_time);
+}
+
+// 64) Probar que se pueden restar segundos a una hora, pasando de 00:00:00 a 23:59:59
+void test_subtract_seconds_to_time_across_midnight(void) {
+
+    static const clock_time_t time = {
+        .time.hours = {0, 0},
+        .time.minutes = {0, 1},
+        .time.seconds = {0, 0},
+    };
+
+    clock_time_t new_time = {0};
+
+    TEST_ASSERT_TRUE(ClockTimeAddSeconds(&time, -61, &new_time));
+    TEST_ASSERT_TIME(2, 3, 5, 9, 5, 9, new_time);
+}
+
+// 65) Probar que sumar varias horas o días de segundos se calcula correctamente
+void test_add_hours_and_days_of_seconds_to_time(void) {
+
+    static const clock_time_t time = {
+        .time.hours = {1, 3},
+        .time.minutes = {3, 0},
+        .time.seconds = {0, 0},
+    };
+
+    clock_time_t new_time = {0};
+
+    TEST_ASSERT_TRUE(ClockTimeAddSeconds(&time, 2 * 3600 + 5 * 60, &new_time));
+    TEST_ASSERT_TIME(1, 5, 3, 5, 0, 0, new_time);
+
+    TEST_ASSERT_TRUE(ClockTimeAddSeconds(&time, 3 * 86400 + 30, &new_time));
+    TEST_ASSERT_TIME(1, 3, 3, 0, 3, 0, new_time);
+}
+
+// 66) Probar que no se pueden sumar segundos a una hora inválida
+void test_add_seconds_to_invalid_time(void) {
+
+    static const clock_time_t time = {
+        .time.hours = {2, 4},
+        .time.minutes = {0, 0},
+        .time.seconds = {0, 0},
+    };
+
+    clock_time_t new_time = {0};
+
+    TEST_ASSERT_FALSE(ClockTimeAddSeconds(&time, 10, &new_time));
+}
+
+// 67) Probar que la alarma pospuesta cerca de la medianoche vuelve a sonar al día siguiente
+void test_alarm_snoozed_across_midnight(void) {
+
+    static const clock_time_t current_time = {
+        .time.hours = {2, 3},
+        .time.minutes = {5, 9},
+        .time.seconds = {4, 0},
+    };
+
+    static const clock_time_t alarm_time = {
+        .time.hours = {2, 3},
+        .time.minutes = {5, 9},
+        .time.seconds = {5, 0},
+    };
+
+    ClockSetTime(clock, &current_time);
+    ClockSetAlarm(clock, &alarm_time);
+
+    SimulateNSeconds(clock, 15);
+    TEST_ASSERT_TRUE(ClockGetIfAlarmIsRinging(clock));
+
+    ClockSnoozeAlarm(clock);
+    TEST_ASSERT_FALSE(ClockGetIfAlarmIsRinging(clock));
+
+    SimulateNSeconds(clock, CLOCK_SNOOZE_SECONDS - 2);
+    TEST_ASSERT_FALSE(ClockGetIfAlarmIsRinging(clock));
+
+    SimulateNSeconds(clock, 3);
+    TEST_ASSERT_TRUE(ClockGetIfAlarmIsRinging(clock));
+}
+
+// 68) Probar que, con una base de tiempo libre, la hora avanza sin llamar a ClockTick()
+void test_time_advances_from_tick_source(void) {
+
+    static const clock_time_t current_time = {
+        .time.hours = {1, 4},
+        .time.minutes = {3, 0},
+        .time.seconds = {5, 8},
+    };
+
+    clock_time_t new_time = {0};
+
+    fake_ticks = 1000;
+    ClockSetTickSource(clock, FakeTickSource);
+    ClockSetTime(clock, &current_time);
+
+    fake_ticks += 3 * CLOCK_TICKS_PER_SECOND - 1;
+    ClockGetTime(clock, &new_time);
+    TEST_ASSERT_TIME(1, 4, 3, 1, 0, 0, new_time);
+
+    fake_ticks += 1;
+    ClockGetTime(clock, &new_time);
+    TEST_ASSERT_TIME(1, 4, 3, 1, 0, 1, new_time);
+}
+
+// 69) Probar que se puede saber cuántos ticks faltan para la próxima alarma
+void test_ticks_to_next_alarm(void) {
+
+    static const clock_time_t current_time = {
+        .time.hours = {1, 3},
+        .time.minutes = {5, 1},
+        .time.seconds = {2, 4},
+    };
+
+    static const clock_time_t alarm_time = {
+        .time.hours = {1, 3},
+        .time.minutes = {5, 1},
+        .time.seconds = {3, 4},
+    };
+
+    TEST_ASSERT_EQUAL_UINT32(CLOCK_NO_ALARM_PENDING, ClockGetTicksToNextAlarm(clock));
+
+    ClockSetTime(clock, &current_time);
+    ClockSetAlarm(clock, &alarm_time);
+    TEST_ASSERT_EQUAL_UINT32(10 * CLOCK_TICKS_PER_SECOND, ClockGetTicksToNextAlarm(clock));
+
+    ClockTick(clock);
+    TEST_ASSERT_EQUAL_UINT32(10 * CLOCK_TICKS_PER_SECOND - 1, ClockGetTicksToNextAlarm(clock));
+
+    ClockDisableAlarm(clock);
+    TEST_ASSERT_EQUAL_UINT32(CLOCK_NO_ALARM_PENDING, ClockGetTicksToNextAlarm(clock));
+}
+
+// 70) Probar que, con una base de tiempo libre, la alarma suena al sincronizar el reloj en el instante calculado
+void test_alarm_rings_when_tick_source_reaches_next_alarm(void) {
+
+    static const clock_time_t current_time = {
+        .time.hours = {1, 3},
+        .time.minutes = {5, 1},
+        .time.seconds = {2, 4},
+    };
+
+    static const clock_time_t alarm_time = {
+        .time.hours = {1, 3},
+        .time.minutes = {5, 1},
+        .time.seconds = {3, 4},
+    };
+
+    uint32_t ticks;
+
+    fake_ticks = 0;
+    ClockSetTickSource(clock, FakeTickSource);
+    ClockSetTime(clock, &current_time);
+    ClockSetAlarm(clock, &alarm_time);
+
+    ticks = ClockGetTicksToNextAlarm(clock);
+
+    fake_ticks += ticks - 1;
+    ClockSync(clock);
+    TEST_ASSERT_FALSE(ClockGetIfAlarmIsRinging(clock));
+
+    fake_ticks += 1;
+    ClockSync(clock);
+    TEST_ASSERT_TRUE(ClockGetIfAlarmIsRinging(clock));
+}
+
+// 71) Probar que la base de tiempo libre puede desbordar sin afectar a la hora
+void test_tick_source_overflow(void) {
+
+    static const clock_time_t current_time = {
+        .time.hours = {2, 3},
+        .time.minutes = {5, 9},
+        .time.seconds = {5, 9},
+    };
+
+    clock_time_t new_time = {0};
+
+    fake_ticks = 0xFFFFFFFFU - 2;
+    ClockSetTickSource(clock, FakeTickSource);
+    ClockSetTime(clock, &current_time);
+
+    fake_ticks += CLOCK_TICKS_PER_SECOND;
+    ClockSync(clock);
+    ClockGetTime(clock, &new_time);
+    TEST_ASSERT_TIME(0, 0, 0, 0, 0, 0, new_time);
+}
+
+// 72) Probar que la alarma suena en el mismo segundo en que la hora actual alcanza la hora de la alarma
+void test_alarm_rings_exactly_when_alarm_time_is_reached(void) {
+
+    static const clock_time_t current_time = {
+        .time.hours = {1, 3},
+        .time.minutes = {5, 1},
+        .time.seconds = {2, 4},
+    };
+
+    static const clock_time_t alarm_time = {
+        .time.hours = {1, 3},
+        .time.minutes = {5, 1},
+        .time.seconds = {3, 4},
+    };
+
+    clock_time_t new_time = {0};
+
+    ClockSetTime(clock, &current_time);
+    ClockSetAlarm(clock, &alarm_time);
+
+    SimulateNSeconds(clock, 9);
+    TEST_ASSERT_FALSE(ClockGetIfAlarmIsRinging(clock));
+
+    SimulateNSeconds(clock, 1);
+    ClockGetTime(clock, &new_time);
+    TEST_ASSERT_TIME(1, 3, 5, 1, 3, 4, new_time);
+    TEST_ASSERT_TRUE(ClockGetIfAlarmIsRinging(clock));
+}
+
+// 73) Probar que la alarma suena si un ajuste de la hora salta hacia adelante por encima de la hora de la alarma
+void test_alarm_rings_when_time_is_adjusted_past_alarm_time(void) {
+
+    static const clock_time_t current_time = {
+        .time.hours = {0, 6},
+        .time.minutes = {5, 9},
+        .time.seconds = {5, 0},
+    };
+
+    static const clock_time_t alarm_time = {
+        .time.hours = {0, 7},
+        .time.minutes = {0, 0},
+        .time.seconds = {0, 0},
+    };
+
+    static const clock_time_t resync_time = {
+        .time.hours = {0, 7},
+        .time.minutes = {0, 1},
+        .time.seconds = {3, 0},
+    };
+
+    ClockSetTime(clock, &current_time);
+    ClockSetAlarm(clock, &alarm_time);
+
+    ClockSetTime(clock, &resync_time);
+    TEST_ASSERT_TRUE(ClockGetIfAlarmIsRinging(clock));
+}
+
+// 74) Probar que la alarma no suena si el ajuste de la hora es hacia atrás o salta demasiado hacia adelante
+void test_alarm_does_not_ring_when_time_is_adjusted_backwards_or_too_far(void) {
+
+    static const clock_time_t current_time = {
+        .time.hours = {0, 7},
+        .time.minutes = {0, 1},
+        .time.seconds = {0, 0},
+    };
+
+    static const clock_time_t alarm_time = {
+        .time.hours = {0, 7},
+        .time.minutes = {0, 0},
+        .time.seconds = {3, 0},
+    };
+
+    static const clock_time_t earlier_time = {
+        .time.hours = {0, 6},
+        .time.minutes = {5, 9},
+        .time.seconds = {0, 0},
+    };
+
+    static const clock_time_t much_later_time = {
+        .time.hours = {1, 2},
+        .time.minutes = {0, 0},
+        .time.seconds = {0, 0},
+    };
+
+    ClockSetTime(clock, &current_time);
+    ClockSetAlarm(clock, &alarm_time);
+
+    ClockSetTime(clock, &earlier_time);
+    TEST_ASSERT_FALSE(ClockGetIfAlarmIsRinging(clock));
+
+    ClockSetTime(clock, &much_later_time);
+    TEST_ASSERT_FALSE(ClockGetIfAlarmIsRinging(clock));
+}
+
+// 75) Probar que las alarmas suenan en orden cronológico sin importar el orden en el que se setearon
+void test_alarms_ring_in_chronological_order(void) {
+
+    static const clock_time_t current_time = {
+        .time.hours = {1, 0},
+        .time.minutes = {0, 0},
+        .time.seconds = {0, 0},
+    };
+
+    static const clock_time_t first_alarm = {
+        .time.hours = {1, 0},
+        .time.minutes = {0, 0},
+        .time.seconds = {1, 0},
+    };
+
+    static const clock_time_t second_alarm = {
+        .time.hours = {1, 0},
+        .time.minutes = {0, 0},
+        .time.seconds = {2, 0},
+    };
+
+    static const clock_time_t third_alarm = {
+        .time.hours = {1, 0},
+        .time.minutes = {0, 0},
+        .time.seconds = {3, 0},
+    };
+
+    ClockSetTime(clock, &current_time);
+    ClockSetAlarmSlot(clock, 1, &third_alarm, NULL);
+    ClockSetAlarmSlot(clock, 2, &first_alarm, NULL);
+    ClockSetAlarmSlot(clock, 3, &second_alarm, NULL);
+    TEST_ASSERT_EQUAL_UINT32(10 * CLOCK_TICKS_PER_SECOND, ClockGetTicksToNextAlarm(clock));
+
+    SimulateNSeconds(clock, 10);
+    TEST_ASSERT_TRUE(ClockGetIfAlarmSlotIsRinging(clock, 2));
+    TEST_ASSERT_FALSE(ClockGetIfAlarmSlotIsRinging(clock, 3));
+    TEST_ASSERT_FALSE(ClockGetIfAlarmSlotIsRinging(clock, 1));
+    TEST_ASSERT_EQUAL_UINT32(10 * CLOCK_TICKS_PER_SECOND, ClockGetTicksToNextAlarm(clock));
+
+    SimulateNSeconds(clock, 10);
+    TEST_ASSERT_TRUE(ClockGetIfAlarmSlotIsRinging(clock, 3));
+    TEST_ASSERT_FALSE(ClockGetIfAlarmSlotIsRinging(clock, 1));
+
+    SimulateNSeconds(clock, 10);
+    TEST_ASSERT_TRUE(ClockGetIfAlarmSlotIsRinging(clock, 1));
+}
+
+// 76) Probar que el orden de las alarmas tiene en cuenta el paso de 23:59:59 a 00:00:00
+void test_alarms_are_ordered_across_midnight(void) {
+
+    static const clock_time_t current_time = {
+        .time.hours = {2, 3},
+        .time.minutes = {5, 9},
+        .time.seconds = {5, 0},
+    };
+
+    static const clock_time_t after_midnight = {
+        .time.hours = {0, 0},
+        .time.minutes = {0, 0},
+        .time.seconds = {0, 5},
+    };
+
+    static const clock_time_t before_midnight = {
+        .time.hours = {2, 3},
+        .time.minutes = {5, 9},
+        .time.seconds = {5, 5},
+    };
+
+    ClockSetTime(clock, &current_time);
+    ClockSetAlarmSlot(clock, 1, &after_midnight, NULL);
+    ClockSetAlarmSlot(clock, 2, &before_midnight, NULL);
+    TEST_ASSERT_EQUAL_UINT32(5 * CLOCK_TICKS_PER_SECOND, ClockGetTicksToNextAlarm(clock));
+
+    SimulateNSeconds(clock, 5);
+    TEST_ASSERT_TRUE(ClockGetIfAlarmSlotIsRinging(clock, 2));
+    TEST_ASSERT_FALSE(ClockGetIfAlarmSlotIsRinging(clock, 1));
+    TEST_ASSERT_EQUAL_UINT32(10 * CLOCK_TICKS_PER_SECOND, ClockGetTicksToNextAlarm(clock));
+
+    SimulateNSeconds(clock, 10);
+    TEST_ASSERT_TRUE(ClockGetIfAlarmSlotIsRinging(clock, 1));
+}
+
+// 77) Probar que dos alarmas seteadas a la misma hora suenan en el mismo segundo y se pueden posponer por separado
+void test_simultaneous_alarms_ring_together(void) {
+
+    static const clock_time_t current_time = {
+        .time.hours = {0, 7},
+        .time.minutes = {0, 0},
+        .time.seconds = {0, 0},
+    };
+
+    static const clock_time_t alarm_time = {
+        .time.hours = {0, 7},
+        .time.minutes = {0, 0},
+        .time.seconds = {3, 0},
+    };
+
+    ClockSetTime(clock, &current_time);
+    ClockSetAlarm(clock, &alarm_time);
+    ClockSetAlarmSlot(clock, CLOCK_MAX_ALARMS - 1, &alarm_time, NULL);
+
+    SimulateNSeconds(clock, 29);
+    TEST_ASSERT_FALSE(ClockGetIfAlarmIsRinging(clock));
+    TEST_ASSERT_FALSE(ClockGetIfAlarmSlotIsRinging(clock, CLOCK_MAX_ALARMS - 1));
+
+    SimulateNSeconds(clock, 1);
+    TEST_ASSERT_TRUE(ClockGetIfAlarmIsRinging(clock));
+    TEST_ASSERT_TRUE(ClockGetIfAlarmSlotIsRinging(clock, CLOCK_MAX_ALARMS - 1));
+
+    ClockSnoozeAlarmSlot(clock, CLOCK_MAX_ALARMS - 1);
+    TEST_ASSERT_TRUE(ClockGetIfAlarmIsRinging(clock));
+    TEST_ASSERT_FALSE(ClockGetIfAlarmSlotIsRinging(clock, CLOCK_MAX_ALARMS - 1));
+    TEST_ASSERT_EQUAL_UINT32(CLOCK_SNOOZE_SECONDS * CLOCK_TICKS_PER_SECOND, ClockGetTicksToNextAlarm(clock));
+}
+
+// 78) Probar que no se puede setear una alarma con un número de alarma fuera de la tabla
+void test_alarm_slot_out_of_range_can_not_be_set(void) {
+
+    static const clock_time_t alarm_time = {
+        .time.hours = {0, 7},
+        .time.minutes = {0, 0},
+        .time.seconds = {0, 0},
+    };
+
+    clock_time_t new_alarm = {0};
+
+    TEST_ASSERT_FALSE(ClockSetAlarmSlot(clock, CLOCK_MAX_ALARMS, &alarm_time, NULL));
+    TEST_ASSERT_FALSE(ClockGetAlarmSlot(clock, CLOCK_MAX_ALARMS, &new_alarm));
+    TEST_ASSERT_EQUAL_UINT32(CLOCK_NO_ALARM_PENDING, ClockGetTicksToNextAlarm(clock));
+}
+
+// 79) Probar que se puede avanzar el reloj una cantidad arbitraria de ticks de una sola vez
+void test_clock_advance_many_ticks_at_once(void) {
+
+    static const clock_time_t current_time = {
+        .time.hours = {1, 0},
+        .time.minutes = {0, 0},
+        .time.seconds = {0, 0},
+    };
+
+    clock_time_t new_time = {0};
+
+    ClockSetTime(clock, &current_time);
+
+    ClockAdvance(clock, CLOCK_TICKS_PER_SECOND - 2);
+    ClockGetTime(clock, &new_time);
+    TEST_ASSERT_TIME(1, 0, 0, 0, 0, 0, new_time);
+
+    ClockAdvance(clock, 2);
+    ClockGetTime(clock, &new_time);
+    TEST_ASSERT_TIME(1, 0, 0, 0, 0, 1, new_time);
+
+    ClockAdvance(clock, (24U * 3600U + 3600U + 61U) * CLOCK_TICKS_PER_SECOND);
+    ClockGetTime(clock, &new_time);
+    TEST_ASSERT_TIME(1, 1, 0, 1, 0, 2, new_time);
+}
+
+// 80) Probar que al avanzar el reloj de una sola vez suenan en orden las alarmas del intervalo salteado
+void test_clock_advance_fires_alarms_in_order(void) {
+
+    static const clock_time_t current_time = {
+        .time.hours = {1, 0},
+        .time.minutes = {0, 0},
+        .time.seconds = {0, 0},
+    };
+
+    static const clock_time_t first_alarm = {
+        .time.hours = {1, 0},
+        .time.minutes = {0, 0},
+        .time.seconds = {1, 0},
+    };
+
+    static const clock_time_t second_alarm = {
+        .time.hours = {1, 0},
+        .time.minutes = {0, 0},
+        .time.seconds = {3, 0},
+    };
+
+    ringing_count = 0;
+    ClockSetTime(clock, &current_time);
+    ClockSetAlarmSlot(clock, 1, &second_alarm, &second_driver);
+    ClockSetAlarmSlot(clock, 2, &first_alarm, &first_driver);
+
+    ClockAdvance(clock, 60 * CLOCK_TICKS_PER_SECOND);
+    TEST_ASSERT_EQUAL_UINT8(2, ringing_count);
+    TEST_ASSERT_EQUAL_UINT8(1, ringing_log[0]);
+    TEST_ASSERT_EQUAL_UINT8(2, ringing_log[1]);
+    TEST_ASSERT_TRUE(ClockGetIfAlarmSlotIsRinging(clock, 1));
+    TEST_ASSERT_TRUE(ClockGetIfAlarmSlotIsRinging(clock, 2));
+}
+
+// 81) Probar que al avanzar el reloj de una sola vez suena la alarma pospuesta
+void test_clock_advance_fires_snoozed_alarm(void) {
+
+    static const clock_time_t current_time = {
+        .time.hours = {0, 7},
+        .time.minutes = {0, 0},
+        .time.seconds = {0, 0},
+    };
+
+    ClockSetTime(clock, &current_time);
+    ClockSetAlarm(clock, &current_time);
+    ClockRingAlarm(clock);
+    ClockSnoozeAlarm(clock);
+    TEST_ASSERT_FALSE(ClockGetIfAlarmIsRinging(clock));
+
+    ClockAdvance(clock, CLOCK_SNOOZE_SECONDS * CLOCK_TICKS_PER_SECOND - 1);
+    TEST_ASSERT_FALSE(ClockGetIfAlarmIsRinging(clock));
+
+    ClockAdvance(clock, 1);
+    TEST_ASSERT_TRUE(ClockGetIfAlarmIsRinging(clock));
+}
+
+// 82) Probar que se puede avanzar el reloj un año completo y la alarma queda sonando
+void test_clock_advance_one_year(void) {
+
+    static const clock_time_t current_time = {
+        .time.hours = {1, 2},
+        .time.minutes = {3, 4},
+        .time.seconds = {5, 6},
+    };
+
+    static const clock_time_t alarm_time = {
+        .time.hours = {0, 6},
+        .time.minutes = {3, 0},
+        .time.seconds = {0, 0},
+    };
+
+    clock_time_t new_time = {0};
+
+    ClockSetTime(clock, &current_time);
+    ClockSetAlarm(clock, &alarm_time);
+
+    ClockAdvance(clock, 365U * 24U * 3600U * CLOCK_TICKS_PER_SECOND);
+    ClockGetTime(clock, &new_time);
+    TEST_ASSERT_TIME(1, 2, 3, 4, 5, 6, new_time);
+    TEST_ASSERT_TRUE(ClockGetIfAlarmIsRinging(clock));
+}
+
+// 83) Probar que se notifica cada cambio de segundo y cada cambio de minuto
+void test_notify_second_and_minute_rollover(void) {
+
+    static const clock_time_t current_time = {
+        .time.hours = {1, 0},
+        .time.minutes = {0, 0},
+        .time.seconds = {5, 8},
+    };
+
+    notified_events = 0;
+    notify_count = 0;
+    ClockSetTime(clock, &current_time);
+    ClockSetNotificationSink(clock, FakeNotify, &notify_count, CLOCK_EVENT_SECOND | CLOCK_EVENT_MINUTE);
+
+    ClockAdvance(clock, CLOCK_TICKS_PER_SECOND - 1);
+    TEST_ASSERT_EQUAL_UINT32(0, notify_count);
+
+    ClockTick(clock);
+    TEST_ASSERT_EQUAL_UINT32(1, notify_count);
+    TEST_ASSERT_EQUAL_HEX32(CLOCK_EVENT_SECOND, notified_events);
+    TEST_ASSERT_EQUAL_PTR(&notify_count, notified_context);
+
+    notified_events = 0;
+    SimulateNSeconds(clock, 1);
+    TEST_ASSERT_EQUAL_UINT32(2, notify_count);
+    TEST_ASSERT_EQUAL_HEX32(CLOCK_EVENT_SECOND | CLOCK_EVENT_MINUTE, notified_events);
+}
+
+// 84) Probar que se notifica cuando suena una alarma y cuando vence su posposición
+void test_notify_alarm_fired_and_snooze_expired(void) {
+
+    static const clock_time_t current_time = {
+        .time.hours = {0, 7},
+        .time.minutes = {0, 0},
+        .time.seconds = {0, 0},
+    };
+
+    static const clock_time_t alarm_time = {
+        .time.hours = {0, 7},
+        .time.minutes = {0, 0},
+        .time.seconds = {0, 5},
+    };
+
+    notified_events = 0;
+    notify_count = 0;
+    ClockSetTime(clock, &current_time);
+    ClockSetAlarm(clock, &alarm_time);
+    ClockSetNotificationSink(clock, FakeNotify, NULL, CLOCK_EVENT_ALARM);
+
+    SimulateNSeconds(clock, 5);
+    TEST_ASSERT_EQUAL_UINT32(1, notify_count);
+    TEST_ASSERT_EQUAL_HEX32(CLOCK_EVENT_ALARM_FIRED, notified_events);
+
+    notified_events = 0;
+    ClockSnoozeAlarm(clock);
+    SimulateNSeconds(clock, CLOCK_SNOOZE_SECONDS);
+    TEST_ASSERT_EQUAL_UINT32(2, notify_count);
+    TEST_ASSERT_EQUAL_HEX32(CLOCK_EVENT_SNOOZE_EXPIRED, notified_events);
+}
+
+// 85) Probar que solo se notifican los eventos suscriptos y que se puede dejar de notificar
+void test_notify_only_subscribed_events(void) {
+
+    static const clock_time_t current_time = {
+        .time.hours = {1, 0},
+        .time.minutes = {0, 0},
+        .time.seconds = {5, 9},
+    };
+
+    notified_events = 0;
+    notify_count = 0;
+    ClockSetTime(clock, &current_time);
+    ClockSetNotificationSink(clock, FakeNotify, NULL, CLOCK_EVENT_MINUTE);
+
+    SimulateNSeconds(clock, 30);
+    TEST_ASSERT_EQUAL_UINT32(1, notify_count);
+    TEST_ASSERT_EQUAL_HEX32(CLOCK_EVENT_MINUTE, notified_events);
+
+    ClockSetNotificationSink(clock, NULL, NULL, 0);
+    SimulateNSeconds(clock, 60);
+    TEST_ASSERT_EQUAL_UINT32(1, notify_count);
+}
+
+// 86) Probar que al avanzar el reloj de una sola vez todos los eventos se entregan en una única notificación
+void test_notify_all_events_of_an_advance_at_once(void) {
+
+    static const clock_time_t current_time = {
+        .time.hours = {0, 7},
+        .time.minutes = {0, 0},
+        .time.seconds = {0, 0},
+    };
+
+    static const clock_time_t alarm_time = {
+        .time.hours = {0, 7},
+        .time.minutes = {0, 1},
+        .time.seconds = {0, 0},
+    };
+
+    notified_events = 0;
+    notify_count = 0;
+    ClockSetTime(clock, &current_time);
+    ClockSetAlarm(clock, &alarm_time);
+    ClockSetNotificationSink(clock, FakeNotify, NULL, CLOCK_EVENT_SECOND | CLOCK_EVENT_MINUTE | CLOCK_EVENT_ALARM);
+
+    ClockAdvance(clock, 600 * CLOCK_TICKS_PER_SECOND);
+    TEST_ASSERT_EQUAL_UINT32(1, notify_count);
+    TEST_ASSERT_EQUAL_HEX32(CLOCK_EVENT_SECOND | CLOCK_EVENT_MINUTE | CLOCK_EVENT_ALARM_FIRED, notified_events);
+}
+
+// 87) Probar que se puede crear un reloj en una memoria reservada por la aplicación y que funciona normalmente
+void test_create_clock_in_static_storage(void) {
+    static clock_storage_t storage;
+    clock_time_t current_time = {0};
+
+    static const clock_time_t alarm_time = {
+        .time.hours = {0, 0},
+        .time.minutes = {0, 1},
+        .time.seconds = {0, 0},
+    };
+
+    clock = ClockCreateStatic(&storage, CLOCK_TICKS_PER_SECOND, CLOCK_SNOOZE_SECONDS, &driver);
+    TEST_ASSERT_EQUAL_PTR(&storage, clock);
+    TEST_ASSERT_FALSE(ClockGetTime(clock, &current_time));
+
+    ClockSetTime(clock, &current_time);
+    ClockSetAlarm(clock, &alarm_time);
+    SimulateNSeconds(clock, 60);
+    TEST_ASSERT_TRUE(ClockGetIfAlarmIsRinging(clock));
+}
+
+// 88) Probar que no se crea el reloj si no se indica la memoria donde crearlo
+void test_create_clock_in_static_storage_without_storage(void) {
+    TEST_ASSERT_NULL(ClockCreateStatic(NULL, CLOCK_TICKS_PER_SECOND, CLOCK_SNOOZE_SECONDS, &driver));
+}
+
+// 89) Probar que si otra tarea sincroniza el reloj en medio de una modificación, los ticks no se aplican dos veces y la
+// agenda de alarmas queda consistente
+void test_sync_preempting_an_update_does_not_apply_ticks_twice(void) {
+    clock_time_t current_time;
+
+    static const clock_time_t start_time = {
+        .time.hours = {1, 2},
+        .time.minutes = {0, 0},
+        .time.seconds = {0, 0},
+    };
+
+    static const clock_time_t first_alarm = {
+        .time.hours = {1, 2},
+        .time.minutes = {0, 0},
+        .time.seconds = {0, 3},
+    };
+
+    static const clock_time_t second_alarm = {
+        .time.hours = {1, 2},
+        .time.minutes = {0, 1},
+        .time.seconds = {1, 0},
+    };
+
+    fake_ticks = 0;
+    preempt_sync = false;
+    ringing_count = 0;
+    ClockSetTickSource(clock, PreemptedTickSource);
+    ClockSetTime(clock, &start_time);
+    ClockSetAlarmSlot(clock, 1, &first_alarm, &first_driver);
+
+    // La modificación lee 25 ticks y, antes de usarlos, otra tarea sincroniza el reloj con 26 ticks y hace sonar la alarma
+    fake_ticks += 5 * CLOCK_TICKS_PER_SECOND;
+    preempt_sync = true;
+    ClockIncrementMinutes(clock);
+    ClockGetTime(clock, &current_time);
+    TEST_ASSERT_TIME(1, 2, 0, 1, 0, 5, current_time);
+    TEST_ASSERT_EQUAL_UINT8(1, ringing_count);
+    TEST_ASSERT_EQUAL_UINT32((86400 - 62) * CLOCK_TICKS_PER_SECOND - 1, ClockGetTicksToNextAlarm(clock));
+
+    // Lo mismo mientras se agrega otra alarma: cada alarma queda una sola vez en la agenda, en el orden correcto
+    preempt_sync = true;
+    ClockSetAlarmSlot(clock, 2, &second_alarm, &second_driver);
+    TEST_ASSERT_EQUAL_UINT32(5 * CLOCK_TICKS_PER_SECOND - 2, ClockGetTicksToNextAlarm(clock));
+
+    ClockAdvance(clock, 86400 * CLOCK_TICKS_PER_SECOND);
+    TEST_ASSERT_EQUAL_UINT8(3, ringing_count);
+    TEST_ASSERT_EQUAL_UINT8(2, ringing_log[1]);
+    TEST_ASSERT_EQUAL_UINT8(1, ringing_log[2]);
+    ClockGetTime(clock, &current_time);
+    TEST_ASSERT_TIME(1, 2, 0, 1, 0, 5, current_time);
+}
+
+// 90) Probar que se pueden sumar y restar varios minutos de una vez, sin modificar las horas
+void test_add_several_minutes_at_once(void) {
+
+    static const clock_time_t current_time = {
+        .time.hours = {1, 2},
+        .time.minutes = {5, 8},
+        .time.seconds = {3, 0},
+    };
+
+    clock_time_t new_time = {0};
+
+    ClockSetTime(clock, &current_time);
+    ClockAddMinutes(clock, 5);
+    ClockGetTime(clock, &new_time);
+    TEST_ASSERT_TIME(1, 2, 0, 3, 3, 0, new_time);
+
+    ClockAddMinutes(clock, -10);
+    ClockGetTime(clock, &new_time);
+    TEST_ASSERT_TIME(1, 2, 5, 3, 3, 0, new_time);
+
+    ClockAddMinutes(clock, 125);
+    ClockGetTime(clock, &new_time);
+    TEST_ASSERT_TIME(1, 2, 5, 8, 3, 0, new_time);
+}
+
+// 91) Probar que se pueden sumar y restar varias horas de una vez, pasando por la medianoche
+void test_add_several_hours_at_once(void) {
+
+    static const clock_time_t current_time = {
+        .time.hours = {2, 2},
+        .time.minutes = {1, 5},
+        .time.seconds = {0, 0},
+    };
+
+    clock_time_t new_time = {0};
+
+    ClockSetTime(clock, &current_time);
+    ClockAddHours(clock, 3);
+    ClockGetTime(clock, &new_time);
+    TEST_ASSERT_TIME(0, 1, 1, 5, 0, 0, new_time);
+
+    ClockAddHours(clock, -5);
+    ClockGetTime(clock, &new_time);
+    TEST_ASSERT_TIME(2, 0, 1, 5, 0, 0, new_time);
+
+    ClockAddHours(clock, 49);
+    ClockGetTime(clock, &new_time);
+    TEST_ASSERT_TIME(2, 1, 1, 5, 0, 0, new_time);
+}
+
+// 92) Probar que sumar varios minutos u horas de una vez sincroniza el reloj una sola vez
+void test_adding_several_units_syncs_only_once(void) {
+
+    static const clock_time_t current_time = {
+        .time.hours = {1, 2},
+        .time.minutes = {0, 0},
+        .time.seconds = {0, 0},
+    };
+
+    clock_time_t new_time = {0};
+
+    fake_ticks = 0;
+    ClockSetTickSource(clock, CountingTickSource);
+    ClockSetTime(clock, &current_time);
+
+    source_reads = 0;
+    ClockAddMinutes(clock, 10);
+    TEST_ASSERT_EQUAL_UINT16(1, source_reads);
+
+    source_reads = 0;
+    ClockAddHours(clock, -1);
+    TEST_ASSERT_EQUAL_UINT16(1, source_reads);
+
+    ClockGetTime(clock, &new_time);
+    TEST_ASSERT_TIME(1, 1, 1, 0, 0, 0, new_time);
+}
+
+// 93) Probar que se pueden calcular los minutos y las horas sumados a otra hora, sin modificar el reloj
+void test_add_minutes_and_hours_to_time(void) {
+
+    static const clock_time_t current_time = {
+        .time.hours = {0, 7},
+        .time.minutes = {0, 0},
+        .time.seconds = {0, 0},
+    };
+
+    static const clock_time_t time = {
+        .time.hours = {2, 3},
+        .time.minutes = {5, 5},
+        .time.seconds = {1, 0},
+    };
+
+    static const clock_time_t invalid_time = {
+        .time.hours = {2, 4},
+        .time.minutes = {0, 0},
+        .time.seconds = {0, 0},
+    };
+
+    clock_time_t new_time = {0};
+
+    ClockSetTime(clock, &current_time);
+
+    TEST_ASSERT_TRUE(ClockTimeAddMinutes(&time, 10, &new_time));
+    TEST_ASSERT_TIME(2, 3, 0, 5, 1, 0, new_time);
+    TEST_ASSERT_TRUE(ClockTimeAddMinutes(&time, -56, &new_time));
+    TEST_ASSERT_TIME(2, 3, 5, 9, 1, 0, new_time);
+
+    TEST_ASSERT_TRUE(ClockTimeAddHours(&time, 2, &new_time));
+    TEST_ASSERT_TIME(0, 1, 5, 5, 1, 0, new_time);
+    TEST_ASSERT_TRUE(ClockTimeAddHours(&time, -24, &new_time));
+    TEST_ASSERT_TIME(2, 3, 5, 5, 1, 0, new_time);
+
+    TEST_ASSERT_FALSE(ClockTimeAddMinutes(&invalid_time, 1, &new_time));
+    TEST_ASSERT_FALSE(ClockTimeAddHours(&invalid_time, 1, &new_time));
+
+    ClockGetTime(clock, &new_time);
+    TEST_ASSERT_TIME(0, 7, 0, 0, 0, 0, new_time);
+}
+
+// 94) Probar que si se cancela la alarma, al día siguiente se notifica como una alarma nueva y no como una posposición
+void test_cancelled_alarm_notifies_alarm_fired_next_day(void) {
+
+    static const clock_time_t current_time = {
+        .time.hours = {0, 7},
+        .time.minutes = {0, 0},
+        .time.seconds = {0, 0},
+    };
+
+    static const clock_time_t alarm_time = {
+        .time.hours = {0, 7},
+        .time.minutes = {0, 0},
+        .time.seconds = {0, 5},
+    };
+
+    notified_events = 0;
+    notify_count = 0;
+    ClockSetTime(clock, &current_time);
+    ClockSetAlarm(clock, &alarm_time);
+    ClockSetNotificationSink(clock, FakeNotify, NULL, CLOCK_EVENT_ALARM);
+
+    SimulateNSeconds(clock, 5);
+    TEST_ASSERT_EQUAL_UINT32(1, notify_count);
+    TEST_ASSERT_EQUAL_HEX32(CLOCK_EVENT_ALARM_FIRED, notified_events);
+
+    notified_events = 0;
+    SimulateNSeconds(clock, 10);
+    ClockCancelAlarm(clock);
+    TEST_ASSERT_FALSE(ClockGetIfAlarmIsRinging(clock));
+
+    SimulateNSeconds(clock, CLOCK_SNOOZE_SECONDS);
+    TEST_ASSERT_FALSE(ClockGetIfAlarmIsRinging(clock));
+    TEST_ASSERT_EQUAL_UINT32(1, notify_count);
+
+    SimulateNSeconds(clock, 24 * 60 * 60 - 10 - CLOCK_SNOOZE_SECONDS);
+    TEST_ASSERT_TRUE(ClockGetIfAlarmIsRinging(clock));
+    TEST_ASSERT_EQUAL_UINT32(2, notify_count);
+    TEST_ASSERT_EQUAL_HEX32(CLOCK_EVENT_ALARM_FIRED, notified_events);
+}
+
 /* === End of documentation ======================================================================================== */
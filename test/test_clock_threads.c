@@ -0,0 +1,252 @@
+/*********************************************************************************************************************
+Copyright (c) 2025, Facundo Sonzogni <facundosonzogni1@gmail.com>
+Copyright (c) 2025, Laboratorio de Microprocesadores, Universidad Nacional de Tucumán
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*********************************************************************************************************************/
+
+/** @file test_clock_threads.c
+ ** @brief Pruebas de estrés de la lectura concurrente de la hora del Reloj, utilizando hilos POSIX
+ ** LISTADO DE PRUEBAS:
+ ** - 1) Probar que mientras un hilo avanza el reloj con ClockTick(), los lectores siempre obtienen una hora válida
+ **      y que nunca retrocede
+ ** - 2) Probar que mientras un hilo sincroniza el reloj con una base de tiempo libre, los lectores siempre obtienen
+ **      una hora válida y que nunca retrocede
+ **/
+
+/* === Headers files inclusions ==================================================================================== */
+
+#define _POSIX_C_SOURCE 200809L
+
+// <pthread.h> incluye <time.h>, cuyos "clock_t" y "clock()" chocan con los nombres del módulo de Reloj
+#define clock_t posix_clock_t
+#define clock   posix_clock
+#include <pthread.h>
+#undef clock_t
+#undef clock
+
+#include "unity.h"
+#include "clock.h"
+
+/* === Macros definitions ========================================================================================== */
+
+#define CLOCK_TICKS_PER_SECOND 10     //!< Ticks por segundo del reloj que se somete a prueba
+#define CLOCK_SNOOZE_SECONDS   60     //!< Segundos que se pospone la alarma (no se utiliza en estas pruebas)
+#define STRESS_SECONDS         80000U //!< Segundos que avanza el escritor (menos de un día, para que la hora no vuelva a 00:00:00)
+#define STRESS_READERS         3      //!< Cantidad de hilos lectores que consultan la hora en simultáneo
+#define STRESS_SYNC_PERIOD     7U     //!< Cada cuántos ticks de la base de tiempo libre se sincroniza el reloj
+
+/* === Private data type declarations ============================================================================== */
+
+//! Resultado de un hilo lector
+typedef struct reader_result_s {
+    uint32_t reads;  //!< Cantidad de lecturas realizadas
+    uint32_t errors; //!< Cantidad de lecturas inválidas o en las que la hora retrocedió
+} reader_result_t;
+
+/* === Private function declarations =============================================================================== */
+
+/**
+ * @brief Función de SetUp que crea el reloj en 00:00:00
+ *
+ */
+void setUp(void);
+
+/**
+ * @brief Hilo lector que consulta la hora hasta que el escritor termina, verificando cada lectura
+ *
+ * @param argument Puntero a la estructura donde se guardará el resultado del hilo
+ * @return void* Siempre NULL
+ */
+static void* ReaderThread(void* argument);
+
+/**
+ * @brief Hilo escritor que avanza el reloj llamando a ClockTick()
+ *
+ * @param argument No se utiliza
+ * @return void* Siempre NULL
+ */
+static void* TickWriterThread(void* argument);
+
+/**
+ * @brief Hilo escritor que avanza la base de tiempo libre y sincroniza el reloj cada tanto
+ *
+ * @param argument No se utiliza
+ * @return void* Siempre NULL
+ */
+static void* SyncWriterThread(void* argument);
+
+/**
+ * @brief Función que ejecuta un escritor y varios lectores en simultáneo y verifica los resultados
+ *
+ * @param writer Función del hilo escritor
+ */
+static void RunStress(void* (*writer)(void*));
+
+/**
+ * @brief Base de tiempo libre simulada, que se puede leer desde cualquier hilo
+ *
+ * @return uint32_t Cuenta actual de ticks de la base de tiempo simulada
+ */
+static uint32_t FakeTickSource(void);
+
+/**
+ * @brief Función que permite simular el encendido del sonido de la alarma
+ */
+static void ClockAlarmTurnOn(void);
+
+/**
+ * @brief Función que permite simular el apagado del sonido de la alarma
+ */
+static void ClockAlarmTurnOff(void);
+
+/* === Private variable definitions ================================================================================ */
+
+//! Reloj compartido entre los hilos
+static clock_t clock;
+
+//! Indica a los lectores que el escritor terminó
+static volatile bool writer_done;
+
+//! Cuenta de ticks de la base de tiempo simulada
+static volatile uint32_t fake_ticks;
+
+//! Estructura constante que representa el driver del reloj con las funciones de callback
+static const struct clock_alarm_driver_s driver = {
+    .ClockAlarmTurnOn = ClockAlarmTurnOn,
+    .ClockAlarmTurnOff = ClockAlarmTurnOff,
+};
+
+/* === Public variable definitions ================================================================================= */
+
+/* === Private function definitions ================================================================================ */
+
+void setUp(void) {
+    static const clock_time_t midnight = {0};
+
+    clock = ClockCreate(CLOCK_TICKS_PER_SECOND, CLOCK_SNOOZE_SECONDS, &driver);
+    ClockSetTime(clock, &midnight);
+    writer_done = false;
+    fake_ticks = 0;
+}
+
+static void* ReaderThread(void* argument) {
+    reader_result_t* result = argument;
+    clock_time_t time;
+    uint32_t seconds;
+    uint32_t previous = 0;
+    bool done;
+
+    do {
+        // Se toma la bandera antes de leer, para hacer al menos una lectura luego de que el escritor termina
+        done = writer_done;
+
+        if (!ClockGetTime(clock, &time) || !ClockTimeAddSeconds(&time, 0, &time)) {
+            result->errors++;
+        } else {
+            seconds = (time.time.hours[0] * 10U + time.time.hours[1]) * 3600U;
+            seconds += (time.time.minutes[0] * 10U + time.time.minutes[1]) * 60U;
+            seconds += time.time.seconds[0] * 10U + time.time.seconds[1];
+
+            if (seconds < previous) {
+                result->errors++;
+            }
+            previous = seconds;
+        }
+        result->reads++;
+    } while (!done);
+
+    return NULL;
+}
+
+static void* TickWriterThread(void* argument) {
+    (void)argument;
+
+    for (uint32_t tick = 0; tick < STRESS_SECONDS * CLOCK_TICKS_PER_SECOND; tick++) {
+        ClockTick(clock);
+    }
+
+    return NULL;
+}
+
+static void* SyncWriterThread(void* argument) {
+    (void)argument;
+
+    ClockSetTickSource(clock, FakeTickSource);
+    for (uint32_t tick = 0; tick < STRESS_SECONDS * CLOCK_TICKS_PER_SECOND; tick++) {
+        fake_ticks = fake_ticks + 1;
+        if (tick % STRESS_SYNC_PERIOD == 0) {
+            ClockSync(clock);
+        }
+    }
+
+    return NULL;
+}
+
+static void RunStress(void* (*writer)(void*)) {
+    pthread_t readers[STRESS_READERS];
+    pthread_t writer_thread;
+    reader_result_t results[STRESS_READERS] = {0};
+    clock_time_t time;
+
+    for (int i = 0; i < STRESS_READERS; i++) {
+        TEST_ASSERT_EQUAL_INT(0, pthread_create(&readers[i], NULL, ReaderThread, &results[i]));
+    }
+    TEST_ASSERT_EQUAL_INT(0, pthread_create(&writer_thread, NULL, writer, NULL));
+
+    pthread_join(writer_thread, NULL);
+    writer_done = true;
+    for (int i = 0; i < STRESS_READERS; i++) {
+        pthread_join(readers[i], NULL);
+        TEST_ASSERT_TRUE(results[i].reads > 0);
+        TEST_ASSERT_EQUAL_UINT32(0, results[i].errors);
+    }
+
+    ClockSync(clock);
+    ClockGetTime(clock, &time);
+    TEST_ASSERT_EQUAL_UINT8(2, time.time.hours[0]);
+    TEST_ASSERT_EQUAL_UINT8(2, time.time.hours[1]);
+    TEST_ASSERT_EQUAL_UINT8(1, time.time.minutes[0]);
+    TEST_ASSERT_EQUAL_UINT8(3, time.time.minutes[1]);
+    TEST_ASSERT_EQUAL_UINT8(2, time.time.seconds[0]);
+    TEST_ASSERT_EQUAL_UINT8(0, time.time.seconds[1]);
+}
+
+static uint32_t FakeTickSource(void) {
+    return fake_ticks;
+}
+
+static void ClockAlarmTurnOn(void) {
+}
+
+static void ClockAlarmTurnOff(void) {
+}
+
+/* === Public function definitions ================================================================================= */
+
+// 1) Probar que mientras un hilo avanza el reloj con ClockTick(), los lectores siempre obtienen una hora válida
+//    y que nunca retrocede
+void test_readers_get_consistent_time_while_ticking(void) {
+    RunStress(TickWriterThread);
+}
+
+// 2) Probar que mientras un hilo sincroniza el reloj con una base de tiempo libre, los lectores siempre obtienen
+//    una hora válida y que nunca retrocede
+void test_readers_get_consistent_time_while_syncing(void) {
+    RunStress(SyncWriterThread);
+}
+
+/* === End of documentation ======================================================================================== */
@@ -0,0 +1,422 @@
+/*********************************************************************************************************************
+Copyright (c) 2025, Facundo Sonzogni <facundosonzogni1@gmail.com>
+Copyright (c) 2025, Laboratorio de Microprocesadores, Universidad Nacional de Tucumán
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*********************************************************************************************************************/
+
+/** @file test_key_controller.c
+ ** @brief Pruebas del reconocimiento de gestos de las teclas y de su cola de eventos
+ ** LISTADO DE PRUEBAS:
+ ** - 1) Probar que sin lecturas la cola está vacía
+ ** - 2) Probar que una pulsación y su liberación se encolan en orden y con la cuenta de ticks de cada lectura
+ ** - 3) Probar que la pulsación larga se encola una única vez, al cumplirse su tiempo
+ ** - 4) Probar que una tecla que se suelta antes del tiempo de pulsación larga no la genera
+ ** - 5) Probar que una tecla mantenida se repite luego del retardo inicial y después con su período
+ ** - 6) Probar que dos pulsaciones dentro del tiempo de doble pulsación generan el evento de doble pulsación
+ ** - 7) Probar que dos pulsaciones separadas por más del tiempo de doble pulsación no lo generan
+ ** - 8) Probar que la pulsación que completa una doble pulsación no inicia otra
+ ** - 9) Probar que las teclas sin tiempos configurados solo generan pulsaciones y liberaciones
+ ** - 10) Probar que una ráfaga de eventos se conserva completa y en orden mientras no se llene la cola
+ ** - 11) Probar que con la cola llena los eventos nuevos se descartan y se cuentan como perdidos
+ ** - 12) Probar que se avisa a la función registrada solo cuando se encolan eventos
+ ** - 13) Probar que los tiempos se miden correctamente cuando la cuenta de ticks desborda
+ ** - 14) Probar que la repetición se acelera al alcanzar cada etapa de aceleración
+ ** - 15) Probar que las repeticiones de una etapa con varias unidades informan esas unidades y el resto de los eventos una
+ ** - 16) Probar que al soltar y volver a pulsar, la repetición recomienza desde la etapa lenta
+ **/
+
+/* === Headers files inclusions ==================================================================================== */
+
+#include "unity.h"
+#include "key_controller.h"
+
+/* === Macros definitions ========================================================================================== */
+
+#define KEY_PLAIN      0 //!< Tecla sin gestos configurados
+#define KEY_LONG       1 //!< Tecla con pulsación larga
+#define KEY_REPEAT     2 //!< Tecla con repetición
+#define KEY_DOUBLE     3 //!< Tecla con doble pulsación
+#define KEY_ACCEL      4 //!< Tecla con repetición acelerada
+
+#define LONG_TICKS     3000 //!< Tiempo de pulsación larga de KEY_LONG
+#define REPEAT_DELAY   500  //!< Retardo de la primera repetición de KEY_REPEAT
+#define REPEAT_PERIOD  100  //!< Período de las repeticiones siguientes de KEY_REPEAT
+#define DOUBLE_TICKS   300  //!< Tiempo máximo entre las dos pulsaciones de una doble pulsación de KEY_DOUBLE
+#define FAST_AT        1000 //!< Tiempo de pulsación a partir del cual se acelera la repetición de KEY_ACCEL
+#define FAST_PERIOD    20   //!< Período de repetición acelerado de KEY_ACCEL
+#define TENS_AT        2000 //!< Tiempo de pulsación a partir del cual cada repetición de KEY_ACCEL vale diez unidades
+#define TENS_PERIOD    50   //!< Período de repetición de KEY_ACCEL al avanzar de a diez unidades
+
+#define BIT(key)       (1U << (key)) //!< Bit de una tecla en las lecturas del teclado
+
+/* === Private data type declarations ============================================================================== */
+
+/* === Private function declarations =============================================================================== */
+
+/**
+ * @brief Función de SetUp que crea el gestor de teclas con sus cinco teclas
+ *
+ */
+void setUp(void);
+
+/**
+ * @brief Función auxiliar que entrega al gestor una lectura simulada del teclado
+ *
+ * @param pressed Teclas que se pulsaron en la lectura
+ * @param released Teclas que se soltaron en la lectura
+ * @param down Teclas que están pulsadas luego de la lectura
+ * @param now Cuenta de ticks de la lectura
+ */
+static void Feed(uint32_t pressed, uint32_t released, uint32_t down, uint32_t now);
+
+/**
+ * @brief Función auxiliar que verifica que el próximo evento de la cola sea el esperado
+ *
+ * @param key Tecla esperada
+ * @param gesture Gesto esperado
+ * @param timestamp Cuenta de ticks esperada
+ */
+static void AssertNextEvent(uint8_t key, key_gesture_t gesture, uint32_t timestamp);
+
+/**
+ * @brief Función de aviso simulada, que cuenta las veces que se la llama
+ *
+ * @param context Puntero al contador de llamadas
+ */
+static void SinkCounter(void* context);
+
+/**
+ * @brief Función auxiliar que mantiene pulsada una tecla con lecturas cada 5 ticks hasta un tiempo dado
+ *
+ * @param key Tecla que se mantiene pulsada
+ * @param from Cuenta de ticks de la primera lectura
+ * @param to Cuenta de ticks de la última lectura
+ */
+static void Hold(uint8_t key, uint32_t from, uint32_t to);
+
+/**
+ * @brief Función auxiliar que saca de la cola el próximo evento de repetición, descartando los demás eventos
+ *
+ * @param event Puntero donde se guardará el evento de repetición
+ */
+static void NextRepeat(key_event_t* event);
+
+/* === Private variable definitions ================================================================================ */
+
+//! Gestor de teclas que se somete a prueba
+static key_controller_t controller;
+
+//! Etapas de aceleración de la repetición de KEY_ACCEL
+static const key_repeat_stage_t acceleration[] = {
+    {.after_ticks = FAST_AT, .period_ticks = FAST_PERIOD, .step = 1},
+    {.after_ticks = TENS_AT, .period_ticks = TENS_PERIOD, .step = 10},
+};
+
+//! Tiempos de los gestos de cada tecla
+static const key_thresholds_t keys[] = {
+    [KEY_PLAIN] = {0},
+    [KEY_LONG] = {.long_press_ticks = LONG_TICKS},
+    [KEY_REPEAT] = {.repeat_delay_ticks = REPEAT_DELAY, .repeat_period_ticks = REPEAT_PERIOD},
+    [KEY_DOUBLE] = {.double_click_ticks = DOUBLE_TICKS},
+    [KEY_ACCEL] = {.repeat_delay_ticks = REPEAT_DELAY, .repeat_period_ticks = REPEAT_PERIOD, .acceleration = acceleration, .acceleration_stages = 2},
+};
+
+/* === Public variable definitions ================================================================================= */
+
+/* === Private function definitions ================================================================================ */
+
+void setUp(void) {
+    static key_controller_storage_t storage;
+
+    controller = KeyControllerCreateStatic(&storage, keys, sizeof(keys) / sizeof(keys[0]));
+}
+
+static void Feed(uint32_t pressed, uint32_t released, uint32_t down, uint32_t now) {
+    keyboard_events_t events = {.pressed = pressed, .released = released, .down = down};
+
+    KeyControllerProcess(controller, &events, now);
+}
+
+static void AssertNextEvent(uint8_t key, key_gesture_t gesture, uint32_t timestamp) {
+    key_event_t event;
+
+    TEST_ASSERT_TRUE(KeyControllerGetEvent(controller, &event));
+    TEST_ASSERT_EQUAL_UINT8(key, event.key);
+    TEST_ASSERT_EQUAL_UINT8(1, event.step);
+    TEST_ASSERT_EQUAL_INT(gesture, event.gesture);
+    TEST_ASSERT_EQUAL_UINT32(timestamp, event.timestamp);
+}
+
+static void SinkCounter(void* context) {
+    (*(int*)context)++;
+}
+
+static void Hold(uint8_t key, uint32_t from, uint32_t to) {
+    for (uint32_t now = from; now <= to; now += 5) {
+        Feed(0, 0, BIT(key), now);
+    }
+}
+
+static void NextRepeat(key_event_t* event) {
+    do {
+        TEST_ASSERT_TRUE(KeyControllerGetEvent(controller, event));
+    } while (event->gesture != KEY_GESTURE_REPEAT);
+}
+
+/* === Public function definitions ================================================================================= */
+
+// 1) Probar que sin lecturas la cola está vacía
+void test_empty_queue_without_scans(void) {
+    key_event_t event;
+
+    TEST_ASSERT_FALSE(KeyControllerGetEvent(controller, &event));
+    TEST_ASSERT_EQUAL_UINT32(0, KeyControllerGetLostEvents(controller));
+}
+
+// 2) Probar que una pulsación y su liberación se encolan en orden y con la cuenta de ticks de cada lectura
+void test_press_and_release_are_queued_in_order(void) {
+    key_event_t event;
+
+    Feed(BIT(KEY_PLAIN), 0, BIT(KEY_PLAIN), 100);
+    Feed(0, 0, BIT(KEY_PLAIN), 105);
+    Feed(0, BIT(KEY_PLAIN), 0, 180);
+
+    AssertNextEvent(KEY_PLAIN, KEY_GESTURE_PRESS, 100);
+    AssertNextEvent(KEY_PLAIN, KEY_GESTURE_RELEASE, 180);
+    TEST_ASSERT_FALSE(KeyControllerGetEvent(controller, &event));
+}
+
+// 3) Probar que la pulsación larga se encola una única vez, al cumplirse su tiempo
+void test_long_press_is_queued_once(void) {
+    key_event_t event;
+
+    Feed(BIT(KEY_LONG), 0, BIT(KEY_LONG), 100);
+    Feed(0, 0, BIT(KEY_LONG), 100 + LONG_TICKS - 1);
+    AssertNextEvent(KEY_LONG, KEY_GESTURE_PRESS, 100);
+    TEST_ASSERT_FALSE(KeyControllerGetEvent(controller, &event));
+
+    Feed(0, 0, BIT(KEY_LONG), 100 + LONG_TICKS);
+    Feed(0, 0, BIT(KEY_LONG), 100 + 3 * LONG_TICKS);
+    AssertNextEvent(KEY_LONG, KEY_GESTURE_LONG_PRESS, 100 + LONG_TICKS);
+    TEST_ASSERT_FALSE(KeyControllerGetEvent(controller, &event));
+}
+
+// 4) Probar que una tecla que se suelta antes del tiempo de pulsación larga no la genera
+void test_long_press_not_queued_when_released_early(void) {
+    key_event_t event;
+
+    Feed(BIT(KEY_LONG), 0, BIT(KEY_LONG), 100);
+    Feed(0, BIT(KEY_LONG), 0, 1000);
+    Feed(0, 0, 0, 100 + LONG_TICKS);
+
+    AssertNextEvent(KEY_LONG, KEY_GESTURE_PRESS, 100);
+    AssertNextEvent(KEY_LONG, KEY_GESTURE_RELEASE, 1000);
+    TEST_ASSERT_FALSE(KeyControllerGetEvent(controller, &event));
+}
+
+// 5) Probar que una tecla mantenida se repite luego del retardo inicial y después con su período
+void test_held_key_repeats_after_delay_then_with_period(void) {
+    key_event_t event;
+
+    Feed(BIT(KEY_REPEAT), 0, BIT(KEY_REPEAT), 0);
+    for (uint32_t now = 5; now <= REPEAT_DELAY + 2 * REPEAT_PERIOD; now += 5) {
+        Feed(0, 0, BIT(KEY_REPEAT), now);
+    }
+
+    AssertNextEvent(KEY_REPEAT, KEY_GESTURE_PRESS, 0);
+    AssertNextEvent(KEY_REPEAT, KEY_GESTURE_REPEAT, REPEAT_DELAY);
+    AssertNextEvent(KEY_REPEAT, KEY_GESTURE_REPEAT, REPEAT_DELAY + REPEAT_PERIOD);
+    AssertNextEvent(KEY_REPEAT, KEY_GESTURE_REPEAT, REPEAT_DELAY + 2 * REPEAT_PERIOD);
+    TEST_ASSERT_FALSE(KeyControllerGetEvent(controller, &event));
+}
+
+// 6) Probar que dos pulsaciones dentro del tiempo de doble pulsación generan el evento de doble pulsación
+void test_two_quick_presses_make_a_double_click(void) {
+    Feed(BIT(KEY_DOUBLE), 0, BIT(KEY_DOUBLE), 100);
+    Feed(0, BIT(KEY_DOUBLE), 0, 200);
+    Feed(BIT(KEY_DOUBLE), 0, BIT(KEY_DOUBLE), 100 + DOUBLE_TICKS);
+
+    AssertNextEvent(KEY_DOUBLE, KEY_GESTURE_PRESS, 100);
+    AssertNextEvent(KEY_DOUBLE, KEY_GESTURE_RELEASE, 200);
+    AssertNextEvent(KEY_DOUBLE, KEY_GESTURE_PRESS, 100 + DOUBLE_TICKS);
+    AssertNextEvent(KEY_DOUBLE, KEY_GESTURE_DOUBLE_CLICK, 100 + DOUBLE_TICKS);
+}
+
+// 7) Probar que dos pulsaciones separadas por más del tiempo de doble pulsación no lo generan
+void test_slow_presses_are_not_a_double_click(void) {
+    key_event_t event;
+
+    Feed(BIT(KEY_DOUBLE), 0, BIT(KEY_DOUBLE), 100);
+    Feed(0, BIT(KEY_DOUBLE), 0, 200);
+    Feed(BIT(KEY_DOUBLE), 0, BIT(KEY_DOUBLE), 101 + DOUBLE_TICKS);
+
+    AssertNextEvent(KEY_DOUBLE, KEY_GESTURE_PRESS, 100);
+    AssertNextEvent(KEY_DOUBLE, KEY_GESTURE_RELEASE, 200);
+    AssertNextEvent(KEY_DOUBLE, KEY_GESTURE_PRESS, 101 + DOUBLE_TICKS);
+    TEST_ASSERT_FALSE(KeyControllerGetEvent(controller, &event));
+}
+
+// 8) Probar que la pulsación que completa una doble pulsación no inicia otra
+void test_third_press_does_not_make_another_double_click(void) {
+    key_event_t event;
+
+    Feed(BIT(KEY_DOUBLE), 0, BIT(KEY_DOUBLE), 100);
+    Feed(0, BIT(KEY_DOUBLE), 0, 150);
+    Feed(BIT(KEY_DOUBLE), 0, BIT(KEY_DOUBLE), 200);
+    Feed(0, BIT(KEY_DOUBLE), 0, 250);
+    while (KeyControllerGetEvent(controller, &event)) {
+    }
+
+    Feed(BIT(KEY_DOUBLE), 0, BIT(KEY_DOUBLE), 300);
+    AssertNextEvent(KEY_DOUBLE, KEY_GESTURE_PRESS, 300);
+    TEST_ASSERT_FALSE(KeyControllerGetEvent(controller, &event));
+}
+
+// 9) Probar que las teclas sin tiempos configurados solo generan pulsaciones y liberaciones
+void test_plain_key_only_presses_and_releases(void) {
+    key_event_t event;
+
+    Feed(BIT(KEY_PLAIN), 0, BIT(KEY_PLAIN), 100);
+    Feed(0, 0, BIT(KEY_PLAIN), 100 + LONG_TICKS);
+    Feed(0, BIT(KEY_PLAIN), 0, 200 + LONG_TICKS);
+    Feed(BIT(KEY_PLAIN), 0, BIT(KEY_PLAIN), 210 + LONG_TICKS);
+
+    AssertNextEvent(KEY_PLAIN, KEY_GESTURE_PRESS, 100);
+    AssertNextEvent(KEY_PLAIN, KEY_GESTURE_RELEASE, 200 + LONG_TICKS);
+    AssertNextEvent(KEY_PLAIN, KEY_GESTURE_PRESS, 210 + LONG_TICKS);
+    TEST_ASSERT_FALSE(KeyControllerGetEvent(controller, &event));
+}
+
+// 10) Probar que una ráfaga de eventos se conserva completa y en orden mientras no se llene la cola
+void test_burst_is_kept_in_order(void) {
+    uint32_t now = 0;
+
+    for (uint32_t index = 0; index < KEY_CONTROLLER_QUEUE_LENGTH / 2; index++) {
+        Feed(BIT(KEY_PLAIN), 0, BIT(KEY_PLAIN), now++);
+        Feed(0, BIT(KEY_PLAIN), 0, now++);
+    }
+
+    for (uint32_t index = 0; index < KEY_CONTROLLER_QUEUE_LENGTH / 2; index++) {
+        AssertNextEvent(KEY_PLAIN, KEY_GESTURE_PRESS, 2 * index);
+        AssertNextEvent(KEY_PLAIN, KEY_GESTURE_RELEASE, 2 * index + 1);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, KeyControllerGetLostEvents(controller));
+}
+
+// 11) Probar que con la cola llena los eventos nuevos se descartan y se cuentan como perdidos
+void test_full_queue_drops_and_counts_new_events(void) {
+    for (uint32_t index = 0; index < KEY_CONTROLLER_QUEUE_LENGTH + 2; index++) {
+        Feed(BIT(KEY_PLAIN), 0, BIT(KEY_PLAIN), index);
+    }
+    TEST_ASSERT_EQUAL_UINT32(2, KeyControllerGetLostEvents(controller));
+
+    AssertNextEvent(KEY_PLAIN, KEY_GESTURE_PRESS, 0);
+    Feed(0, BIT(KEY_PLAIN), 0, 1000);
+    TEST_ASSERT_EQUAL_UINT32(2, KeyControllerGetLostEvents(controller));
+}
+
+// 12) Probar que se avisa a la función registrada solo cuando se encolan eventos
+void test_sink_called_only_when_events_are_queued(void) {
+    int calls = 0;
+
+    KeyControllerSetNotificationSink(controller, SinkCounter, &calls);
+
+    Feed(0, 0, 0, 100);
+    TEST_ASSERT_EQUAL_INT(0, calls);
+
+    Feed(BIT(KEY_PLAIN) | BIT(KEY_LONG), 0, BIT(KEY_PLAIN) | BIT(KEY_LONG), 200);
+    TEST_ASSERT_EQUAL_INT(1, calls);
+
+    Feed(0, 0, BIT(KEY_PLAIN) | BIT(KEY_LONG), 300);
+    TEST_ASSERT_EQUAL_INT(1, calls);
+}
+
+// 13) Probar que los tiempos se miden correctamente cuando la cuenta de ticks desborda
+void test_timing_across_tick_count_overflow(void) {
+    Feed(BIT(KEY_LONG), 0, BIT(KEY_LONG), 0xFFFFFF00U);
+    Feed(0, 0, BIT(KEY_LONG), LONG_TICKS - 0x100U);
+
+    AssertNextEvent(KEY_LONG, KEY_GESTURE_PRESS, 0xFFFFFF00U);
+    AssertNextEvent(KEY_LONG, KEY_GESTURE_LONG_PRESS, LONG_TICKS - 0x100U);
+}
+
+// 14) Probar que la repetición se acelera al alcanzar cada etapa de aceleración
+void test_repeat_accelerates_at_each_stage(void) {
+    key_event_t event;
+    uint32_t previous;
+
+    Feed(BIT(KEY_ACCEL), 0, BIT(KEY_ACCEL), 0);
+    Hold(KEY_ACCEL, 5, FAST_AT);
+    while (KeyControllerGetEvent(controller, &event)) {
+    }
+
+    // La repetición vencida en FAST_AT ya programa la siguiente con el período acelerado
+    Hold(KEY_ACCEL, FAST_AT + 5, FAST_AT + FAST_PERIOD + REPEAT_PERIOD);
+    NextRepeat(&event);
+    previous = event.timestamp;
+    NextRepeat(&event);
+    TEST_ASSERT_EQUAL_UINT32(FAST_PERIOD, event.timestamp - previous);
+    TEST_ASSERT_EQUAL_UINT8(1, event.step);
+}
+
+// 15) Probar que las repeticiones de una etapa con varias unidades informan esas unidades y el resto de los eventos una
+void test_repeats_report_the_step_of_their_stage(void) {
+    key_event_t event;
+    uint32_t previous;
+
+    Feed(BIT(KEY_ACCEL), 0, BIT(KEY_ACCEL), 0);
+    Hold(KEY_ACCEL, 5, TENS_AT - 5);
+    while (KeyControllerGetEvent(controller, &event)) {
+    }
+
+    Hold(KEY_ACCEL, TENS_AT, TENS_AT + 2 * TENS_PERIOD);
+    NextRepeat(&event);
+    TEST_ASSERT_EQUAL_UINT8(10, event.step);
+    previous = event.timestamp;
+    NextRepeat(&event);
+    TEST_ASSERT_EQUAL_UINT8(10, event.step);
+    TEST_ASSERT_EQUAL_UINT32(TENS_PERIOD, event.timestamp - previous);
+
+    Feed(0, BIT(KEY_ACCEL), 0, TENS_AT + 3 * TENS_PERIOD);
+    while (KeyControllerGetEvent(controller, &event)) {
+        TEST_ASSERT_EQUAL_UINT8((event.gesture == KEY_GESTURE_REPEAT) ? 10 : 1, event.step);
+    }
+}
+
+// 16) Probar que al soltar y volver a pulsar, la repetición recomienza desde la etapa lenta
+void test_repeat_restarts_slow_after_release(void) {
+    key_event_t event;
+    uint32_t previous;
+
+    Feed(BIT(KEY_ACCEL), 0, BIT(KEY_ACCEL), 0);
+    Hold(KEY_ACCEL, 5, TENS_AT + TENS_PERIOD);
+    Feed(0, BIT(KEY_ACCEL), 0, 5000);
+    while (KeyControllerGetEvent(controller, &event)) {
+    }
+
+    Feed(BIT(KEY_ACCEL), 0, BIT(KEY_ACCEL), 6000);
+    Hold(KEY_ACCEL, 6005, 6000 + REPEAT_DELAY + REPEAT_PERIOD);
+    AssertNextEvent(KEY_ACCEL, KEY_GESTURE_PRESS, 6000);
+    NextRepeat(&event);
+    TEST_ASSERT_EQUAL_UINT32(6000 + REPEAT_DELAY, event.timestamp);
+    TEST_ASSERT_EQUAL_UINT8(1, event.step);
+    previous = event.timestamp;
+    NextRepeat(&event);
+    TEST_ASSERT_EQUAL_UINT32(REPEAT_PERIOD, event.timestamp - previous);
+}
+
+/* === End of documentation ======================================================================================== */
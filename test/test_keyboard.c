@@ -0,0 +1,368 @@
+/*********************************************************************************************************************
+Copyright (c) 2025, Facundo Sonzogni <facundosonzogni1@gmail.com>
+Copyright (c) 2025, Laboratorio de Microprocesadores, Universidad Nacional de Tucumán
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*********************************************************************************************************************/
+
+/** @file test_keyboard.c
+ ** @brief Pruebas del antirrebote y los eventos del teclado, usando lecturas simuladas de todas las teclas
+ ** LISTADO DE PRUEBAS:
+ ** - 1) Probar que sin teclas pulsadas el teclado no genera eventos y queda en reposo
+ ** - 2) Probar que una pulsación se acepta recién luego de KEYBOARD_DEBOUNCE_SCANS lecturas seguidas
+ ** - 3) Probar que un rebote reinicia la cuenta del antirrebote y la tecla genera un único evento
+ ** - 4) Probar que al soltar una tecla se informa el evento de liberación y el teclado vuelve al reposo
+ ** - 5) Probar que varias teclas pulsadas a la vez se informan en la misma lectura
+ ** - 6) Probar que mientras una tecla está pulsada se informa en cada lectura, sin repetir su pulsación
+ ** - 7) Probar que se ignoran los bits de teclas que no existen
+ ** - 8) Probar que la tarea lee las teclas al comenzar y, con el teclado en reposo, se bloquea sin volver a leerlas
+ ** - 9) Probar que la interrupción de una tecla despierta a la tarea, que lee cada KEYBOARD_SCAN_PERIOD_MS mientras
+ **      la tecla está pulsada y se vuelve a bloquear cuando el teclado queda en reposo
+ ** - 10) Probar que una interrupción anterior al comienzo de la tarea no intenta notificarla
+ **
+ ** NOTA: Las pruebas de la tarea reemplazan las funciones de FreeRTOS que utiliza por versiones simuladas con tiempo
+ ** virtual. Cuando la tarea se bloquearía para siempre, la prueba la termina volviendo con longjmp()
+ **/
+
+/* === Headers files inclusions ==================================================================================== */
+
+#include "unity.h"
+#include "keyboard.h"
+#include <setjmp.h>
+#include <stddef.h>
+
+/* === Macros definitions ========================================================================================== */
+
+#define KEY_COUNT 3 //!< Cantidad de teclas del teclado que se somete a prueba
+
+#define BIT_UP    (1U << 0) //!< Bit de la primera tecla en las lecturas y en los eventos del teclado
+#define BIT_DOWN  (1U << 1) //!< Bit de la segunda tecla en las lecturas y en los eventos del teclado
+
+#define FAKE_TASK ((TaskHandle_t)&task_exit) //!< Identificador de la tarea del teclado simulada
+#define HELD_SCANS 10                        //!< Lecturas luego de las cuales se suelta la tecla en las pruebas de la tarea
+
+/* === Private data type declarations ============================================================================== */
+
+/* === Private function declarations =============================================================================== */
+
+/**
+ * @brief Función de SetUp que crea el teclado con sus tres teclas
+ *
+ */
+void setUp(void);
+
+/**
+ * @brief Función auxiliar que procesa varias lecturas iguales de las teclas
+ *
+ * @param sample Estado simulado de las teclas
+ * @param count Cantidad de lecturas
+ * @return uint32_t Teclas pulsadas en todas las lecturas combinadas
+ */
+static uint32_t ScanTimes(uint32_t sample, uint32_t count);
+
+/**
+ * @brief Función auxiliar que ejecuta la tarea del teclado hasta que se bloquearía sin nada que la despierte
+ *
+ * @param interrupt Función que simula la interrupción de una tecla la primera vez que la tarea se bloquea (puede ser NULL)
+ */
+static void RunTask(void (*interrupt)(void));
+
+/**
+ * @brief Función simulada que lee el estado de todas las teclas
+ *
+ * @return uint32_t Estado simulado de las teclas
+ */
+static uint32_t FakeRead(void);
+
+/**
+ * @brief Función simulada que recibe el resultado de cada lectura de la tarea
+ *
+ * @param context Contexto indicado en los argumentos de la tarea
+ * @param scan Eventos producidos por la lectura
+ * @param now Cuenta de ticks en la que se tomó la lectura
+ */
+static void FakeHandler(void* context, const keyboard_events_t* scan, uint32_t now);
+
+/**
+ * @brief Función que simula la interrupción que produce la pulsación de la primera tecla
+ */
+static void PressInterrupt(void);
+
+/* === Private variable definitions ================================================================================ */
+
+//! Teclado que se somete a prueba
+static keyboard_t keyboard;
+
+//! Eventos producidos por la última lectura del teclado
+static keyboard_events_t events;
+
+//! Punto al que se vuelve cuando la tarea se bloquearía para siempre
+static jmp_buf task_exit;
+
+//! Cuenta de ticks del tiempo virtual
+static TickType_t fake_ticks;
+
+//! Estado simulado de las teclas
+static uint32_t fake_keys;
+
+//! Notificaciones pendientes de la tarea simulada
+static uint32_t notifications;
+
+//! Interrupción que se simula la próxima vez que la tarea se bloquea
+static void (*pending_interrupt)(void);
+
+//! Cantidad de lecturas que entregó la tarea
+static uint32_t scans;
+
+//! Cantidad de veces que la tarea se bloqueó esperando una interrupción
+static uint32_t blocks;
+
+//! Cantidad de veces que la tarea esperó el período de lectura
+static uint32_t delays;
+
+//! Instante en el que se informó la pulsación de la primera tecla
+static uint32_t pressed_at;
+
+//! Instante en el que se informó la liberación de la primera tecla
+static uint32_t released_at;
+
+//! Mayor separación entre dos lecturas seguidas de la tarea mientras estuvo despierta
+static uint32_t largest_gap;
+
+/* === Public variable definitions ================================================================================= */
+
+/* === Private function definitions ================================================================================ */
+
+void setUp(void) {
+    static keyboard_storage_t storage;
+
+    keyboard = KeyboardCreateStatic(&storage, KEY_COUNT);
+}
+
+static uint32_t ScanTimes(uint32_t sample, uint32_t count) {
+    uint32_t result = 0;
+
+    for (uint32_t index = 0; index < count; index++) {
+        KeyboardScan(keyboard, sample, &events);
+        result |= events.pressed;
+    }
+
+    return result;
+}
+
+static void RunTask(void (*interrupt)(void)) {
+    struct keyboard_task_args_s args = {
+        .keyboard = keyboard,
+        .read = FakeRead,
+        .handler = FakeHandler,
+        .context = &scans,
+    };
+
+    fake_ticks = 0;
+    fake_keys = 0;
+    notifications = 0;
+    pending_interrupt = interrupt;
+    scans = 0;
+    blocks = 0;
+    delays = 0;
+    pressed_at = 0;
+    released_at = 0;
+    largest_gap = 0;
+
+    if (setjmp(task_exit) == 0) {
+        KeyboardTask(&args);
+    }
+}
+
+static uint32_t FakeRead(void) {
+    return fake_keys;
+}
+
+static void FakeHandler(void* context, const keyboard_events_t* scan, uint32_t now) {
+    static uint32_t previous;
+
+    TEST_ASSERT_EQUAL_PTR(&scans, context);
+    TEST_ASSERT_EQUAL_UINT32(fake_ticks, now);
+
+    if ((delays > 0) && (now - previous > largest_gap)) {
+        largest_gap = now - previous;
+    }
+    previous = now;
+
+    if (scan->pressed & BIT_UP) {
+        pressed_at = now;
+    }
+    if (scan->released & BIT_UP) {
+        released_at = now;
+    }
+    scans++;
+}
+
+static void PressInterrupt(void) {
+    fake_keys = BIT_UP;
+    KeyboardWakeFromISR(keyboard);
+}
+
+TickType_t xTaskGetTickCount(void) {
+    return fake_ticks;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void) {
+    return FAKE_TASK;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t* task_woken) {
+    TEST_ASSERT_EQUAL_PTR(FAKE_TASK, task);
+    notifications++;
+    *task_woken = pdTRUE;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t wait) {
+    void (*interrupt)(void) = pending_interrupt;
+    uint32_t result;
+
+    TEST_ASSERT_EQUAL_UINT32(portMAX_DELAY, wait);
+    blocks++;
+
+    // Mientras la tarea está bloqueada pasa el tiempo hasta que llega la interrupción simulada, si la hay
+    if ((notifications == 0) && (interrupt != NULL)) {
+        pending_interrupt = NULL;
+        fake_ticks += 100;
+        interrupt();
+    }
+    if (notifications == 0) {
+        longjmp(task_exit, 1);
+    }
+
+    result = notifications;
+    notifications = (clear == pdTRUE) ? 0 : notifications - 1;
+    return result;
+}
+
+BaseType_t xTaskDelayUntil(TickType_t* previous, TickType_t increment) {
+    *previous += increment;
+    fake_ticks = *previous;
+    delays++;
+
+    if (delays == HELD_SCANS) {
+        fake_keys = 0;
+    }
+
+    return pdTRUE;
+}
+
+/* === Public function definitions ================================================================================= */
+
+// 1) Probar que sin teclas pulsadas el teclado no genera eventos y queda en reposo
+void test_no_keys_no_events(void) {
+    TEST_ASSERT_EQUAL_HEX32(0, ScanTimes(0, 10));
+    TEST_ASSERT_EQUAL_HEX32(0, events.down);
+    TEST_ASSERT_TRUE(KeyboardIsIdle(keyboard));
+}
+
+// 2) Probar que una pulsación se acepta recién luego de KEYBOARD_DEBOUNCE_SCANS lecturas seguidas
+void test_press_accepted_after_debounce_scans(void) {
+    TEST_ASSERT_EQUAL_HEX32(0, ScanTimes(BIT_UP, KEYBOARD_DEBOUNCE_SCANS - 1));
+    TEST_ASSERT_EQUAL_HEX32(0, events.down);
+    TEST_ASSERT_FALSE(KeyboardIsIdle(keyboard));
+
+    TEST_ASSERT_EQUAL_HEX32(BIT_UP, ScanTimes(BIT_UP, 1));
+    TEST_ASSERT_EQUAL_HEX32(BIT_UP, events.down);
+}
+
+// 3) Probar que un rebote reinicia la cuenta del antirrebote y la tecla genera un único evento
+void test_bounce_restarts_debounce(void) {
+    TEST_ASSERT_EQUAL_HEX32(0, ScanTimes(BIT_UP, KEYBOARD_DEBOUNCE_SCANS - 1));
+    TEST_ASSERT_EQUAL_HEX32(0, ScanTimes(0, 1));
+    TEST_ASSERT_EQUAL_HEX32(0, ScanTimes(BIT_UP, KEYBOARD_DEBOUNCE_SCANS - 1));
+    TEST_ASSERT_EQUAL_HEX32(BIT_UP, ScanTimes(BIT_UP, 1));
+    TEST_ASSERT_EQUAL_HEX32(0, ScanTimes(BIT_UP, 10));
+}
+
+// 4) Probar que al soltar una tecla se informa el evento de liberación y el teclado vuelve al reposo
+void test_release_reported_and_keyboard_idle(void) {
+    ScanTimes(BIT_UP, KEYBOARD_DEBOUNCE_SCANS);
+
+    ScanTimes(0, KEYBOARD_DEBOUNCE_SCANS - 1);
+    TEST_ASSERT_EQUAL_HEX32(0, events.released);
+    TEST_ASSERT_FALSE(KeyboardIsIdle(keyboard));
+
+    ScanTimes(0, 1);
+    TEST_ASSERT_EQUAL_HEX32(BIT_UP, events.released);
+    TEST_ASSERT_EQUAL_HEX32(0, events.down);
+    TEST_ASSERT_TRUE(KeyboardIsIdle(keyboard));
+}
+
+// 5) Probar que varias teclas pulsadas a la vez se informan en la misma lectura
+void test_simultaneous_presses_in_a_single_scan(void) {
+    ScanTimes(BIT_UP | BIT_DOWN, KEYBOARD_DEBOUNCE_SCANS - 1);
+
+    TEST_ASSERT_EQUAL_HEX32(BIT_UP | BIT_DOWN, ScanTimes(BIT_UP | BIT_DOWN, 1));
+}
+
+// 6) Probar que mientras una tecla está pulsada se informa en cada lectura, sin repetir su pulsación
+void test_held_key_reported_as_down(void) {
+    ScanTimes(BIT_DOWN, KEYBOARD_DEBOUNCE_SCANS);
+
+    TEST_ASSERT_EQUAL_HEX32(0, ScanTimes(BIT_DOWN, 100));
+    TEST_ASSERT_EQUAL_HEX32(BIT_DOWN, events.down);
+    TEST_ASSERT_FALSE(KeyboardIsIdle(keyboard));
+}
+
+// 7) Probar que se ignoran los bits de teclas que no existen
+void test_bits_of_unknown_keys_are_ignored(void) {
+    TEST_ASSERT_EQUAL_HEX32(0, ScanTimes(~((1U << KEY_COUNT) - 1U), 10));
+    TEST_ASSERT_TRUE(KeyboardIsIdle(keyboard));
+}
+
+// 8) Probar que la tarea lee las teclas al comenzar y, con el teclado en reposo, se bloquea sin volver a leerlas
+void test_task_blocks_while_keyboard_is_idle(void) {
+    RunTask(NULL);
+
+    TEST_ASSERT_EQUAL_UINT32(1, scans);
+    TEST_ASSERT_EQUAL_UINT32(1, blocks);
+    TEST_ASSERT_EQUAL_UINT32(0, delays);
+}
+
+// 9) Probar que la interrupción de una tecla despierta a la tarea, que lee cada KEYBOARD_SCAN_PERIOD_MS mientras la
+// tecla está pulsada y se vuelve a bloquear cuando el teclado queda en reposo
+void test_task_scans_after_interrupt_until_idle(void) {
+    const uint32_t period = KEYBOARD_SCAN_PERIOD_MS;
+
+    RunTask(PressInterrupt);
+
+    // La interrupción llega en el tick 100, y cada cambio se acepta en la lectura número KEYBOARD_DEBOUNCE_SCANS
+    TEST_ASSERT_EQUAL_UINT32(100 + (KEYBOARD_DEBOUNCE_SCANS - 1) * period, pressed_at);
+    TEST_ASSERT_EQUAL_UINT32(100 + (HELD_SCANS + KEYBOARD_DEBOUNCE_SCANS - 1) * period, released_at);
+    TEST_ASSERT_EQUAL_UINT32(period, largest_gap);
+
+    // Luego de la liberación la tarea no vuelve a leer: se bloquea y, sin otra interrupción, permanece bloqueada
+    TEST_ASSERT_EQUAL_UINT32(2, blocks);
+    TEST_ASSERT_EQUAL_UINT32(HELD_SCANS + KEYBOARD_DEBOUNCE_SCANS - 1, delays);
+    TEST_ASSERT_EQUAL_UINT32(1 + HELD_SCANS + KEYBOARD_DEBOUNCE_SCANS, scans);
+    TEST_ASSERT_EQUAL_UINT32(released_at, fake_ticks);
+}
+
+// 10) Probar que una interrupción anterior al comienzo de la tarea no intenta notificarla
+void test_interrupt_before_task_starts_is_ignored(void) {
+    notifications = 0;
+    KeyboardWakeFromISR(keyboard);
+    KeyboardWakeFromISR(NULL);
+
+    TEST_ASSERT_EQUAL_UINT32(0, notifications);
+}
+
+/* === End of documentation ======================================================================================== */
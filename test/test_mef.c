@@ -0,0 +1,747 @@
+/*********************************************************************************************************************
+Copyright (c) 2025, Facundo Sonzogni <facundosonzogni1@gmail.com>
+Copyright (c) 2025, Laboratorio de Microprocesadores, Universidad Nacional de Tucumán
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*********************************************************************************************************************/
+
+
+/** @file test_mef.c
+ ** @brief Pruebas del núcleo de la MEF del reloj despertador, con tiempo virtual y una pantalla simulada
+ ** LISTADO DE PRUEBAS:
+ ** - 1) Probar que si el reloj no tiene hora se muestra la hora inválida con todos los dígitos parpadeando
+ ** - 2) Probar que si el reloj tiene hora se muestra sin parpadear, con el punto central parpadeando
+ ** - 3) Probar que la pulsación larga de "set_time" comienza el ajuste de los minutos
+ ** - 4) Probar que los minutos avanzan las unidades del evento y las horas siempre de a una
+ ** - 5) Probar que al aceptar los minutos y las horas el reloj queda con la hora ajustada
+ ** - 6) Probar que al cancelar el ajuste el reloj vuelve a la hora que tenía al comenzarlo
+ ** - 7) Probar que sin pulsaciones el ajuste se cancela una única vez, al cumplirse exactamente el tiempo límite
+ ** - 8) Probar que cada pulsación durante un ajuste reinicia el tiempo límite
+ ** - 9) Probar que al ajustar y aceptar la alarma queda activada y se enciende el punto de la alarma
+ ** - 10) Probar que sin la alarma sonando "accept" activa la alarma y "cancel" la desactiva
+ ** - 11) Probar que con la alarma sonando "accept" la pospone y "cancel" la cancela
+ ** - 12) Probar que al cambiar el minuto se redibuja la hora
+ ** - 13) Probar que las entradas que el estado no atiende no modifican la pantalla
+ ** - 14) Probar que el tiempo límite puede configurarse en forma independiente para cada estado
+ ** - 15) Probar que un estado configurado sin tiempo límite no se abandona por falta de pulsaciones
+ ** - 16) Probar que el cambio de minuto no reinicia el tiempo límite de un ajuste
+ ** - 17) Probar una hora completa de uso simulado: ajustar la hora y la alarma, posponerla, cancelarla y ver la hora
+ ** - 18) Probar que un evento acelerado actualiza el reloj las mismas veces que un evento de una sola unidad
+ ** - 19) Probar cuántas veces despierta la tarea en un minuto de cada estado, con una pulsación cada 10 segundos,
+ **       frente al lazo anterior que en los estados de ajuste despertaba en cada tick
+ **/
+
+/* === Headers files inclusions ==================================================================================== */
+
+#include "unity.h"
+#include "clock.h"
+#include "mef.h"
+#include <string.h>
+
+/* === Macros definitions ========================================================================================== */
+
+#define TICKS_PER_SECOND 1000   //!< Ticks por segundo del reloj y de la cuenta de tiempo virtual
+#define SNOOZE_SECONDS   300    //!< Segundos que se pospone la alarma
+#define TIMEOUT          30000  //!< Tiempo sin pulsaciones luego del cual se cancelan los ajustes, en ticks
+#define ONE_MINUTE       60000  //!< Un minuto, en ticks
+#define FLASH_PERIOD     125    //!< Semi-período con el que la MEF hace parpadear los dígitos y los puntos
+
+/* === Private data type declarations ============================================================================== */
+
+//! Estado de la pantalla simulada, tal como lo dejaron las llamadas de la MEF
+typedef struct fake_screen_s {
+    uint8_t digits[4];     //!< Último valor escrito en cada dígito
+    bool dots[4];          //!< Estado del punto de cada dígito
+    uint16_t dot_flash[4]; //!< Semi-período de parpadeo del punto de cada dígito
+    uint8_t flash_from;    //!< Primer dígito que parpadea
+    uint8_t flash_to;      //!< Último dígito que parpadea
+    uint16_t flash_period; //!< Semi-período de parpadeo de los dígitos (0 si no parpadean)
+    uint32_t writes;       //!< Cantidad de llamadas que modificaron la pantalla
+} fake_screen_t;
+
+/* === Private function declarations =============================================================================== */
+
+/**
+ * @brief Función de SetUp que crea un reloj sin hora, la pantalla simulada y la MEF
+ *
+ */
+void setUp(void);
+
+//! Función simulada del driver del reloj que cuenta las veces que comienza a sonar la alarma
+static void AlarmTurnOn(void);
+
+//! Función simulada del driver del reloj que apaga la alarma
+static void AlarmTurnOff(void);
+
+//! Función que recibe las notificaciones del reloj y recuerda los cambios de minuto
+static void ClockNotify(void* context, uint32_t events);
+
+/**
+ * @brief Función auxiliar que pone el reloj en una hora y pone en marcha la MEF
+ *
+ * @param hours Horas
+ * @param minutes Minutos
+ */
+static void StartAt(uint8_t hours, uint8_t minutes);
+
+/**
+ * @brief Función auxiliar que entrega una entrada a la MEF en el instante actual, avanzando una unidad
+ *
+ * @param input Entrada de la MEF
+ */
+static void Input(mef_input_t input);
+
+/**
+ * @brief Función auxiliar que entrega una entrada a la MEF en el instante actual
+ *
+ * @param input Entrada de la MEF
+ * @param step Unidades que avanza la entrada
+ */
+static void InputStep(mef_input_t input, uint8_t step);
+
+/**
+ * @brief Función auxiliar que deja pasar el tiempo virtual, como lo haría la tarea de la MEF
+ *
+ * @param ticks Tiempo que se deja pasar
+ *
+ * NOTA: El tiempo avanza de un salto hasta el tiempo límite de la MEF o el final del intervalo, y en cada salto la MEF
+ * recibe el cambio de minuto, si ocurrió, o una entrada vacía, igual que al despertar la tarea
+ */
+static void Wait(uint32_t ticks);
+
+/**
+ * @brief Función auxiliar que deja pasar el tiempo virtual de a un tick, despertando a la MEF como lo haría la tarea
+ *
+ * @param ticks Tiempo que se deja pasar
+ * @param poll_period Período con el que la tarea despierta en los estados con tiempo límite, o 0 para que solo
+ * despierte con el cambio de minuto o al cumplirse el tiempo límite
+ *
+ * NOTA: Con poll_period igual a 1 se reproduce el lazo anterior de la tarea, que en los estados de ajuste despertaba
+ * en cada tick para revisar el tiempo sin pulsaciones. Cada vez que la tarea despierta se cuenta en "wake_ups"
+ */
+static void RunTask(uint32_t ticks, uint32_t poll_period);
+
+/**
+ * @brief Función auxiliar que entrega una entrada a la MEF como lo haría la tarea al despertar por el evento de tecla
+ *
+ * @param input Entrada de la MEF
+ */
+static void WakeWithKey(mef_input_t input);
+
+/**
+ * @brief Función auxiliar que ajusta la alarma con las teclas
+ *
+ * @param hours Horas de la alarma
+ * @param minutes Minutos de la alarma
+ */
+static void AdjustAlarm(uint8_t hours, uint8_t minutes);
+
+/**
+ * @brief Función auxiliar que entrega al reloj la cuenta del tiempo virtual, contando las veces que la lee
+ *
+ * @return uint32_t Cuenta de ticks del tiempo virtual
+ */
+static uint32_t CountingTickSource(void);
+
+/**
+ * @brief Función auxiliar que verifica los cuatro dígitos de la pantalla simulada
+ *
+ * @param hours Horas esperadas
+ * @param minutes Minutos esperados
+ */
+static void AssertDisplay(uint8_t hours, uint8_t minutes);
+
+/* === Private variable definitions ================================================================================ */
+
+//! Driver simulado de la alarma del reloj
+static const struct clock_alarm_driver_s driver = {
+    .ClockAlarmTurnOn = AlarmTurnOn,
+    .ClockAlarmTurnOff = AlarmTurnOff,
+};
+
+//! Reloj con el que trabaja la MEF
+static clock_t clock;
+
+//! MEF que se somete a prueba
+static mef_t mef;
+
+//! Pantalla simulada
+static fake_screen_t display;
+
+//! Cuenta de ticks del tiempo virtual
+static uint32_t now;
+
+//! Indica que el reloj notificó un cambio de minuto que la MEF todavía no recibió
+static bool minute_changed;
+
+//! Cantidad de veces que la alarma comenzó a sonar
+static uint32_t alarm_turn_on_count;
+
+//! Cantidad de veces que el reloj leyó el tiempo virtual con CountingTickSource()
+static uint32_t source_reads;
+
+//! Cantidad de veces que despertó la tarea simulada por RunTask() y WakeWithKey()
+static uint32_t wake_ups;
+
+/* === Public variable definitions ================================================================================= */
+
+/* === Private function definitions ================================================================================ */
+
+void setUp(void) {
+    static clock_storage_t clock_storage;
+    static mef_storage_t mef_storage;
+
+    clock = ClockCreateStatic(&clock_storage, TICKS_PER_SECOND, SNOOZE_SECONDS, &driver);
+    ClockSetNotificationSink(clock, ClockNotify, NULL, CLOCK_EVENT_MINUTE);
+    mef = MEFCreateStatic(&mef_storage, clock, NULL, TIMEOUT);
+
+    memset(&display, 0, sizeof(display));
+    now = 0;
+    minute_changed = false;
+    alarm_turn_on_count = 0;
+}
+
+static void AlarmTurnOn(void) {
+    alarm_turn_on_count++;
+}
+
+static void AlarmTurnOff(void) {
+}
+
+static void ClockNotify(void* context, uint32_t events) {
+    (void)context;
+
+    if (events & CLOCK_EVENT_MINUTE) {
+        minute_changed = true;
+    }
+}
+
+static void StartAt(uint8_t hours, uint8_t minutes) {
+    clock_time_t time = {
+        .time = {.hours = {hours / 10, hours % 10}, .minutes = {minutes / 10, minutes % 10}, .seconds = {0, 0}},
+    };
+
+    ClockSetTime(clock, &time);
+    minute_changed = false;
+    MEFStart(mef, now);
+}
+
+static void Input(mef_input_t input) {
+    InputStep(input, 1);
+}
+
+static void InputStep(mef_input_t input, uint8_t step) {
+    mef_event_t event = {.input = input, .step = step};
+
+    MEFStep(mef, &event, now);
+}
+
+static void Wait(uint32_t ticks) {
+    uint32_t slice;
+
+    do {
+        slice = MEFGetTicksToTimeout(mef, now);
+        if (slice > ticks) {
+            slice = ticks;
+        }
+
+        ClockAdvance(clock, slice);
+        now += slice;
+        ticks -= slice;
+
+        Input(minute_changed ? MEF_INPUT_CLOCK_MINUTE : MEF_INPUT_NONE);
+        minute_changed = false;
+    } while (ticks > 0);
+}
+
+static void RunTask(uint32_t ticks, uint32_t poll_period) {
+    bool polling;
+
+    for (; ticks > 0; ticks--) {
+        polling = (poll_period != 0) && (MEFGetTicksToTimeout(mef, now) != MEF_NO_TIMEOUT);
+        ClockAdvance(clock, 1);
+        now++;
+
+        if (minute_changed || (MEFGetTicksToTimeout(mef, now) == 0) || (polling && (now % poll_period == 0))) {
+            wake_ups++;
+            Input(minute_changed ? MEF_INPUT_CLOCK_MINUTE : MEF_INPUT_NONE);
+            minute_changed = false;
+        }
+    }
+}
+
+static void WakeWithKey(mef_input_t input) {
+    wake_ups++;
+    Input(minute_changed ? MEF_INPUT_CLOCK_MINUTE : MEF_INPUT_NONE);
+    minute_changed = false;
+    Input(input);
+}
+
+static void AdjustAlarm(uint8_t hours, uint8_t minutes) {
+    Input(MEF_INPUT_SET_ALARM);
+    InputStep(MEF_INPUT_INCREMENT, minutes);
+    Input(MEF_INPUT_ACCEPT);
+    for (uint8_t hour = 0; hour < hours; hour++) {
+        Input(MEF_INPUT_INCREMENT);
+    }
+    Input(MEF_INPUT_ACCEPT);
+}
+
+static uint32_t CountingTickSource(void) {
+    source_reads++;
+
+    return now;
+}
+
+static void AssertDisplay(uint8_t hours, uint8_t minutes) {
+    uint8_t expected[4] = {hours / 10, hours % 10, minutes / 10, minutes % 10};
+
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, display.digits, 4);
+}
+
+/* === Public function definitions ================================================================================= */
+
+//! Pantalla simulada: recuerda los dígitos escritos, que apagan sus puntos como en la pantalla real
+void ScreenWriteBCD(screen_t screen, uint8_t value[], uint8_t size) {
+    (void)screen;
+
+    for (uint8_t index = 0; (index < size) && (index < 4); index++) {
+        display.digits[index] = value[index];
+        display.dots[index] = false;
+    }
+    display.writes++;
+}
+
+//! Pantalla simulada: recuerda los dígitos que parpadean
+int ScreenFlashDigits(screen_t screen, uint8_t from, uint8_t to, uint16_t half_period) {
+    (void)screen;
+
+    display.flash_from = from;
+    display.flash_to = to;
+    display.flash_period = half_period;
+    display.writes++;
+
+    return 0;
+}
+
+//! Pantalla simulada: recuerda el estado de cada punto
+void ScreenSetDotState(screen_t screen, uint8_t digit, bool turn_on) {
+    (void)screen;
+
+    display.dots[digit] = turn_on;
+    display.writes++;
+}
+
+//! Pantalla simulada: recuerda el parpadeo de cada punto
+int ScreenFlashDot(screen_t screen, uint8_t digit, uint16_t half_period) {
+    (void)screen;
+
+    display.dot_flash[digit] = half_period;
+    display.writes++;
+
+    return 0;
+}
+
+// 1) Probar que si el reloj no tiene hora se muestra la hora inválida con todos los dígitos parpadeando
+void test_invalid_time_flashes_all_digits(void) {
+    MEFStart(mef, now);
+
+    TEST_ASSERT_EQUAL(MEF_STATE_INVALID_TIME, MEFGetState(mef));
+    TEST_ASSERT_EQUAL_UINT8(0, display.flash_from);
+    TEST_ASSERT_EQUAL_UINT8(3, display.flash_to);
+    TEST_ASSERT_EQUAL_UINT16(FLASH_PERIOD, display.flash_period);
+    TEST_ASSERT_TRUE(display.dots[2]);
+    TEST_ASSERT_EQUAL_UINT32(MEF_NO_TIMEOUT, MEFGetTicksToTimeout(mef, now));
+}
+
+// 2) Probar que si el reloj tiene hora se muestra sin parpadear, con el punto central parpadeando
+void test_valid_time_shown_without_flashing(void) {
+    StartAt(12, 34);
+
+    TEST_ASSERT_EQUAL(MEF_STATE_SHOWING_CURRENT_TIME, MEFGetState(mef));
+    AssertDisplay(12, 34);
+    TEST_ASSERT_EQUAL_UINT16(0, display.flash_period);
+    TEST_ASSERT_TRUE(display.dots[2]);
+    TEST_ASSERT_EQUAL_UINT16(FLASH_PERIOD, display.dot_flash[2]);
+    TEST_ASSERT_FALSE(display.dots[0]);
+}
+
+// 3) Probar que la pulsación larga de "set_time" comienza el ajuste de los minutos
+void test_set_time_starts_adjusting_minutes(void) {
+    StartAt(12, 34);
+
+    Input(MEF_INPUT_SET_TIME);
+
+    TEST_ASSERT_EQUAL(MEF_STATE_ADJUSTING_TIME_MINUTES, MEFGetState(mef));
+    TEST_ASSERT_EQUAL_UINT8(2, display.flash_from);
+    TEST_ASSERT_EQUAL_UINT8(3, display.flash_to);
+    TEST_ASSERT_EQUAL_UINT16(FLASH_PERIOD, display.flash_period);
+    TEST_ASSERT_EQUAL_UINT16(0, display.dot_flash[2]);
+}
+
+// 4) Probar que los minutos avanzan las unidades del evento y las horas siempre de a una
+void test_minutes_use_event_step_and_hours_move_by_one(void) {
+    StartAt(12, 34);
+    Input(MEF_INPUT_SET_TIME);
+
+    InputStep(MEF_INPUT_INCREMENT, 10);
+    AssertDisplay(12, 44);
+    Input(MEF_INPUT_DECREMENT);
+    AssertDisplay(12, 43);
+
+    Input(MEF_INPUT_ACCEPT);
+    TEST_ASSERT_EQUAL(MEF_STATE_ADJUSTING_TIME_HOURS, MEFGetState(mef));
+    TEST_ASSERT_EQUAL_UINT8(0, display.flash_from);
+    TEST_ASSERT_EQUAL_UINT8(1, display.flash_to);
+
+    InputStep(MEF_INPUT_INCREMENT, 10);
+    AssertDisplay(13, 43);
+    InputStep(MEF_INPUT_DECREMENT, 10);
+    AssertDisplay(12, 43);
+}
+
+// 5) Probar que al aceptar los minutos y las horas el reloj queda con la hora ajustada
+void test_accepting_minutes_and_hours_sets_the_time(void) {
+    clock_time_t time;
+
+    StartAt(12, 34);
+    Input(MEF_INPUT_SET_TIME);
+    Input(MEF_INPUT_INCREMENT);
+    Input(MEF_INPUT_ACCEPT);
+    Input(MEF_INPUT_DECREMENT);
+    Input(MEF_INPUT_ACCEPT);
+
+    TEST_ASSERT_EQUAL(MEF_STATE_SHOWING_CURRENT_TIME, MEFGetState(mef));
+    TEST_ASSERT_TRUE(ClockGetTime(clock, &time));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(((uint8_t[]){1, 1, 3, 5}), time.bcd, 4);
+    AssertDisplay(11, 35);
+    TEST_ASSERT_EQUAL_UINT16(0, display.flash_period);
+}
+
+// 6) Probar que al cancelar el ajuste el reloj vuelve a la hora que tenía al comenzarlo
+void test_cancel_restores_the_previous_time(void) {
+    clock_time_t time;
+
+    StartAt(12, 34);
+    Input(MEF_INPUT_SET_TIME);
+    InputStep(MEF_INPUT_INCREMENT, 10);
+    Input(MEF_INPUT_CANCEL);
+
+    TEST_ASSERT_EQUAL(MEF_STATE_SHOWING_CURRENT_TIME, MEFGetState(mef));
+    ClockGetTime(clock, &time);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(((uint8_t[]){1, 2, 3, 4}), time.bcd, 4);
+    AssertDisplay(12, 34);
+}
+
+// 7) Probar que sin pulsaciones el ajuste se cancela una única vez, al cumplirse exactamente el tiempo límite
+void test_timeout_fires_once_at_the_deadline(void) {
+    StartAt(12, 34);
+    Input(MEF_INPUT_SET_TIME);
+    TEST_ASSERT_EQUAL_UINT32(TIMEOUT, MEFGetTicksToTimeout(mef, now));
+
+    Wait(TIMEOUT - 1);
+    TEST_ASSERT_EQUAL(MEF_STATE_ADJUSTING_TIME_MINUTES, MEFGetState(mef));
+    TEST_ASSERT_EQUAL_UINT32(1, MEFGetTicksToTimeout(mef, now));
+
+    Wait(1);
+    TEST_ASSERT_EQUAL(MEF_STATE_SHOWING_CURRENT_TIME, MEFGetState(mef));
+    TEST_ASSERT_EQUAL_UINT32(MEF_NO_TIMEOUT, MEFGetTicksToTimeout(mef, now));
+
+    Wait(10 * TIMEOUT);
+    TEST_ASSERT_EQUAL(MEF_STATE_SHOWING_CURRENT_TIME, MEFGetState(mef));
+}
+
+// 8) Probar que cada pulsación durante un ajuste reinicia el tiempo límite
+void test_each_press_restarts_the_timeout(void) {
+    StartAt(12, 34);
+    Input(MEF_INPUT_SET_TIME);
+
+    Wait(20000);
+    Input(MEF_INPUT_INCREMENT);
+    Wait(20000);
+    TEST_ASSERT_EQUAL(MEF_STATE_ADJUSTING_TIME_MINUTES, MEFGetState(mef));
+    TEST_ASSERT_EQUAL_UINT32(TIMEOUT - 20000, MEFGetTicksToTimeout(mef, now));
+
+    Input(MEF_INPUT_ACCEPT);
+    Wait(TIMEOUT - 1);
+    TEST_ASSERT_EQUAL(MEF_STATE_ADJUSTING_TIME_HOURS, MEFGetState(mef));
+    Wait(1);
+    TEST_ASSERT_EQUAL(MEF_STATE_SHOWING_CURRENT_TIME, MEFGetState(mef));
+}
+
+// 9) Probar que al ajustar y aceptar la alarma queda activada y se enciende el punto de la alarma
+void test_adjusted_alarm_is_activated(void) {
+    clock_time_t alarm;
+
+    StartAt(12, 34);
+    Input(MEF_INPUT_SET_ALARM);
+    TEST_ASSERT_EQUAL(MEF_STATE_ADJUSTING_ALARM_MINUTES, MEFGetState(mef));
+    AssertDisplay(0, 0);
+    TEST_ASSERT_TRUE(display.dots[0] && display.dots[1] && display.dots[2] && display.dots[3]);
+
+    InputStep(MEF_INPUT_INCREMENT, 10);
+    InputStep(MEF_INPUT_INCREMENT, 10);
+    InputStep(MEF_INPUT_INCREMENT, 10);
+    Input(MEF_INPUT_ACCEPT);
+    TEST_ASSERT_EQUAL(MEF_STATE_ADJUSTING_ALARM_HOURS, MEFGetState(mef));
+    InputStep(MEF_INPUT_DECREMENT, 10);
+    AssertDisplay(23, 30);
+    Input(MEF_INPUT_ACCEPT);
+
+    TEST_ASSERT_EQUAL(MEF_STATE_SHOWING_CURRENT_TIME, MEFGetState(mef));
+    TEST_ASSERT_TRUE(ClockGetAlarm(clock, &alarm));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(((uint8_t[]){2, 3, 3, 0}), alarm.bcd, 4);
+    AssertDisplay(12, 34);
+    TEST_ASSERT_TRUE(display.dots[0]);
+}
+
+// 10) Probar que sin la alarma sonando "accept" activa la alarma y "cancel" la desactiva
+void test_accept_and_cancel_toggle_the_alarm(void) {
+    StartAt(12, 34);
+
+    Input(MEF_INPUT_ACCEPT);
+    TEST_ASSERT_TRUE(ClockGetIfAlarmIsActivated(clock));
+    TEST_ASSERT_TRUE(display.dots[0]);
+
+    Input(MEF_INPUT_CANCEL);
+    TEST_ASSERT_FALSE(ClockGetIfAlarmIsActivated(clock));
+    TEST_ASSERT_FALSE(display.dots[0]);
+}
+
+// 11) Probar que con la alarma sonando "accept" la pospone y "cancel" la cancela
+void test_ringing_alarm_is_snoozed_and_cancelled(void) {
+    StartAt(6, 29);
+    AdjustAlarm(6, 30);
+
+    Wait(ONE_MINUTE);
+    TEST_ASSERT_TRUE(ClockGetIfAlarmIsRinging(clock));
+    TEST_ASSERT_EQUAL_UINT32(1, alarm_turn_on_count);
+
+    Input(MEF_INPUT_ACCEPT);
+    TEST_ASSERT_FALSE(ClockGetIfAlarmIsRinging(clock));
+    Wait(SNOOZE_SECONDS * TICKS_PER_SECOND);
+    TEST_ASSERT_TRUE(ClockGetIfAlarmIsRinging(clock));
+    TEST_ASSERT_EQUAL_UINT32(2, alarm_turn_on_count);
+
+    Input(MEF_INPUT_CANCEL);
+    TEST_ASSERT_FALSE(ClockGetIfAlarmIsRinging(clock));
+    TEST_ASSERT_TRUE(ClockGetIfAlarmIsActivated(clock));
+    TEST_ASSERT_EQUAL(MEF_STATE_SHOWING_CURRENT_TIME, MEFGetState(mef));
+}
+
+// 12) Probar que al cambiar el minuto se redibuja la hora
+void test_clock_minute_redraws_the_time(void) {
+    StartAt(12, 59);
+
+    Wait(ONE_MINUTE);
+
+    AssertDisplay(13, 0);
+    TEST_ASSERT_TRUE(display.dots[2]);
+}
+
+// 13) Probar que las entradas que el estado no atiende no modifican la pantalla
+void test_unhandled_inputs_leave_the_screen_untouched(void) {
+    uint32_t writes;
+
+    StartAt(12, 34);
+    writes = display.writes;
+
+    Input(MEF_INPUT_NONE);
+    Input(MEF_INPUT_INCREMENT);
+    Input(MEF_INPUT_DECREMENT);
+    Input(MEF_INPUT_TIMEOUT);
+
+    TEST_ASSERT_EQUAL_UINT32(writes, display.writes);
+    TEST_ASSERT_EQUAL(MEF_STATE_SHOWING_CURRENT_TIME, MEFGetState(mef));
+}
+
+// 14) Probar que el tiempo límite puede configurarse en forma independiente para cada estado
+void test_timeout_configured_per_state(void) {
+    MEFSetTimeout(mef, MEF_STATE_ADJUSTING_TIME_HOURS, 5000);
+    StartAt(12, 34);
+
+    Input(MEF_INPUT_SET_TIME);
+    TEST_ASSERT_EQUAL_UINT32(TIMEOUT, MEFGetTicksToTimeout(mef, now));
+
+    Input(MEF_INPUT_ACCEPT);
+    TEST_ASSERT_EQUAL_UINT32(5000, MEFGetTicksToTimeout(mef, now));
+    Wait(4999);
+    TEST_ASSERT_EQUAL(MEF_STATE_ADJUSTING_TIME_HOURS, MEFGetState(mef));
+    Wait(1);
+    TEST_ASSERT_EQUAL(MEF_STATE_SHOWING_CURRENT_TIME, MEFGetState(mef));
+}
+
+// 15) Probar que un estado configurado sin tiempo límite no se abandona por falta de pulsaciones
+void test_state_without_timeout_is_kept(void) {
+    MEFSetTimeout(mef, MEF_STATE_ADJUSTING_ALARM_MINUTES, MEF_NO_TIMEOUT);
+    StartAt(12, 34);
+
+    Input(MEF_INPUT_SET_ALARM);
+    TEST_ASSERT_EQUAL_UINT32(MEF_NO_TIMEOUT, MEFGetTicksToTimeout(mef, now));
+    Wait(10 * TIMEOUT);
+    TEST_ASSERT_EQUAL(MEF_STATE_ADJUSTING_ALARM_MINUTES, MEFGetState(mef));
+
+    Input(MEF_INPUT_ACCEPT);
+    TEST_ASSERT_EQUAL_UINT32(TIMEOUT, MEFGetTicksToTimeout(mef, now));
+}
+
+// 16) Probar que el cambio de minuto no reinicia el tiempo límite de un ajuste
+void test_clock_minute_does_not_restart_the_timeout(void) {
+    StartAt(12, 34);
+    Input(MEF_INPUT_SET_TIME);
+
+    Wait(20000);
+    Input(MEF_INPUT_CLOCK_MINUTE);
+    Input(MEF_INPUT_NONE);
+    TEST_ASSERT_EQUAL_UINT32(TIMEOUT - 20000, MEFGetTicksToTimeout(mef, now));
+
+    Wait(TIMEOUT - 20000);
+    TEST_ASSERT_EQUAL(MEF_STATE_SHOWING_CURRENT_TIME, MEFGetState(mef));
+}
+
+// 17) Probar una hora completa de uso simulado: ajustar la hora y la alarma, posponerla, cancelarla y ver la hora
+void test_one_hour_of_scripted_use(void) {
+    clock_time_t time;
+    uint32_t start;
+
+    MEFStart(mef, now);
+    start = now;
+
+    // Se ajusta la hora a las 07:30, con una pausa entre pulsaciones como la de una persona
+    Wait(2000);
+    Input(MEF_INPUT_SET_TIME);
+    for (uint8_t press = 0; press < 3; press++) {
+        Wait(400);
+        InputStep(MEF_INPUT_INCREMENT, 10);
+    }
+    Wait(1000);
+    Input(MEF_INPUT_ACCEPT);
+    for (uint8_t press = 0; press < 7; press++) {
+        Wait(300);
+        Input(MEF_INPUT_INCREMENT);
+    }
+    Wait(1000);
+    Input(MEF_INPUT_ACCEPT);
+    AssertDisplay(7, 30);
+
+    // Se empieza a ajustar la alarma pero se abandona, y el ajuste se cancela solo
+    Wait(5000);
+    Input(MEF_INPUT_SET_ALARM);
+    Input(MEF_INPUT_INCREMENT);
+    Wait(TIMEOUT);
+    TEST_ASSERT_EQUAL(MEF_STATE_SHOWING_CURRENT_TIME, MEFGetState(mef));
+    TEST_ASSERT_FALSE(ClockGetIfAlarmIsActivated(clock));
+
+    // Se ajusta la alarma a las 07:45 y se espera que suene
+    Wait(5000);
+    AdjustAlarm(7, 45);
+    TEST_ASSERT_TRUE(ClockGetIfAlarmIsActivated(clock));
+    Wait(15 * ONE_MINUTE);
+    TEST_ASSERT_TRUE(ClockGetIfAlarmIsRinging(clock));
+    AssertDisplay(7, 45);
+
+    // Se pospone una vez y luego se cancela
+    Wait(10000);
+    Input(MEF_INPUT_ACCEPT);
+    Wait(SNOOZE_SECONDS * TICKS_PER_SECOND);
+    TEST_ASSERT_TRUE(ClockGetIfAlarmIsRinging(clock));
+    Wait(20000);
+    Input(MEF_INPUT_CANCEL);
+    TEST_ASSERT_FALSE(ClockGetIfAlarmIsRinging(clock));
+    TEST_ASSERT_EQUAL_UINT32(2, alarm_turn_on_count);
+
+    // Hasta completar la hora, la pantalla sigue a la hora del reloj en cada cambio de minuto
+    while (now - start < 60 * ONE_MINUTE) {
+        Wait(ONE_MINUTE);
+        ClockGetTime(clock, &time);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(time.bcd, display.digits, 4);
+        TEST_ASSERT_TRUE(display.dots[0]);
+    }
+    TEST_ASSERT_EQUAL(MEF_STATE_SHOWING_CURRENT_TIME, MEFGetState(mef));
+    TEST_ASSERT_EQUAL_UINT32(2, alarm_turn_on_count);
+}
+
+// 18) Probar que un evento acelerado actualiza el reloj las mismas veces que un evento de una sola unidad
+void test_accelerated_event_costs_the_same_clock_updates(void) {
+    uint32_t single_reads;
+
+    StartAt(12, 34);
+    ClockSetTickSource(clock, CountingTickSource);
+    Input(MEF_INPUT_SET_TIME);
+
+    source_reads = 0;
+    Input(MEF_INPUT_INCREMENT);
+    single_reads = source_reads;
+    source_reads = 0;
+    InputStep(MEF_INPUT_INCREMENT, 10);
+    TEST_ASSERT_EQUAL_UINT32(single_reads, source_reads);
+    AssertDisplay(12, 45);
+
+    Input(MEF_INPUT_CANCEL);
+    Input(MEF_INPUT_SET_ALARM);
+    Input(MEF_INPUT_INCREMENT);
+    source_reads = 0;
+    Input(MEF_INPUT_INCREMENT);
+    single_reads = source_reads;
+    source_reads = 0;
+    InputStep(MEF_INPUT_INCREMENT, 10);
+    TEST_ASSERT_EQUAL_UINT32(single_reads, source_reads);
+    AssertDisplay(0, 12);
+}
+
+// 19) Probar cuántas veces despierta la tarea en un minuto de cada estado, con una pulsación cada 10 segundos, frente al
+// lazo anterior que en los estados de ajuste despertaba en cada tick
+void test_task_wake_ups_per_minute_in_each_state(void) {
+    static const struct {
+        mef_state_t state;         //!< Estado que se mide
+        mef_input_t enter[2];      //!< Entradas que llevan al estado desde la hora actual (MEF_INPUT_NONE si sobran)
+        uint32_t polling_wake_ups; //!< Veces que despierta la tarea con el lazo anterior
+        uint32_t wake_ups;         //!< Veces que despierta la tarea con el lazo actual
+    } cases[] = {
+        // El reloj cuenta aunque no tenga hora, por lo que también despierta con el cambio de minuto. Al ajustar la hora,
+        // en cambio, cada pulsación vuelve a fijar los segundos y el minuto no llega a cambiar
+        {MEF_STATE_INVALID_TIME, {MEF_INPUT_NONE, MEF_INPUT_NONE}, 7, 7},
+        {MEF_STATE_SHOWING_CURRENT_TIME, {MEF_INPUT_NONE, MEF_INPUT_NONE}, 7, 7},
+        {MEF_STATE_ADJUSTING_TIME_MINUTES, {MEF_INPUT_SET_TIME, MEF_INPUT_NONE}, 60006, 6},
+        {MEF_STATE_ADJUSTING_TIME_HOURS, {MEF_INPUT_SET_TIME, MEF_INPUT_ACCEPT}, 60006, 6},
+        {MEF_STATE_ADJUSTING_ALARM_MINUTES, {MEF_INPUT_SET_ALARM, MEF_INPUT_NONE}, 60006, 7},
+        {MEF_STATE_ADJUSTING_ALARM_HOURS, {MEF_INPUT_SET_ALARM, MEF_INPUT_ACCEPT}, 60006, 7},
+    };
+
+    for (uint8_t index = 0; index < sizeof(cases) / sizeof(cases[0]); index++) {
+        for (uint32_t poll_period = 0; poll_period <= 1; poll_period++) {
+            setUp();
+            if (cases[index].state == MEF_STATE_INVALID_TIME) {
+                MEFStart(mef, now);
+            } else {
+                StartAt(12, 34);
+            }
+            Input(cases[index].enter[0]);
+            Input(cases[index].enter[1]);
+            TEST_ASSERT_EQUAL(cases[index].state, MEFGetState(mef));
+
+            wake_ups = 0;
+            for (uint8_t press = 0; press < 6; press++) {
+                RunTask(10000, poll_period);
+                WakeWithKey(MEF_INPUT_INCREMENT);
+            }
+            TEST_ASSERT_EQUAL(cases[index].state, MEFGetState(mef));
+            TEST_ASSERT_EQUAL_UINT32(poll_period ? cases[index].polling_wake_ups : cases[index].wake_ups, wake_ups);
+        }
+    }
+}
+
+/* === End of documentation ======================================================================================== */
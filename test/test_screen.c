@@ -0,0 +1,734 @@
+/*********************************************************************************************************************
+Copyright (c) 2025, Facundo Sonzogni <facundosonzogni1@gmail.com>
+Copyright (c) 2025, Laboratorio de Microprocesadores, Universidad Nacional de Tucumán
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*********************************************************************************************************************/
+
+
+/** @file test_screen.c
+ ** @brief Pruebas del refresco de la pantalla, usando un driver simulado que registra lo que se muestra en cada display
+ ** LISTADO DE PRUEBAS:
+ ** - 1) Probar que cada llamada al refresco apaga los displays, envía los segmentos y enciende el siguiente dígito
+ ** - 2) Probar que un número escrito se muestra a partir del cuadro siguiente y conserva los puntos encendidos
+ ** - 3) Probar que el parpadeo de los dígitos apaga sus segmentos durante medio período sin apagar los puntos
+ ** - 4) Probar que el parpadeo de un punto lo apaga durante medio período sin afectar al resto del display
+ ** - 5) Probar que volver a configurar el mismo parpadeo no reinicia su fase
+ ** - 6) Probar que con varios parpadeos y cambios de configuración se muestra lo mismo que al calcular cada cuadro
+ **      por separado, como hacía la versión anterior del refresco
+ ** - 7) Probar que repetir una escritura o una configuración idéntica no cambia la generación y se cuenta como descartada
+ ** - 8) Probar que cada actualización que modifica algo aumenta la generación y se cuenta como aceptada
+ ** - 9) Probar que escribir un número apaga los puntos de los dígitos escritos, aunque los segmentos no cambien
+ ** - 10) Probar que un temporizador simulado que llama a la función de su interrupción barre toda la pantalla, un
+ **       dígito por interrupción, y que la función ignora una pantalla inexistente
+ ** - 11) Probar que con el brillo máximo ningún display se atenúa
+ ** - 12) Probar que los niveles de brillo encienden cada display una fracción creciente de su intervalo, casi nula en
+ **       el nivel más bajo, y que el nivel 0 apaga los segmentos
+ ** - 13) Probar que el brillo de un dígito no afecta a los demás y que se rechazan dígitos y niveles inválidos
+ ** - 14) Probar que sin la función para atenuar del driver los niveles intermedios se muestran con el brillo máximo
+ ** - 15) Probar que ScreenWriteBCD muestra los dígitos hexadecimales y deja en blanco los valores fuera de la tabla
+ ** - 16) Probar que se pueden escribir palabras como "AL", "SnZ" o "Err" y que los caracteres no representables
+ **       quedan en blanco
+ ** - 17) Probar que un punto en el texto se muestra en el dígito anterior y que un texto largo se trunca
+ ** - 18) Probar que se pueden escribir los segmentos de varios dígitos en una sola llamada
+ ** - 19) Probar que un mensaje de una sola pasada entra por la derecha, sale por la izquierda al ritmo indicado,
+ **       avisa que terminó y la pantalla vuelve a mostrar lo escrito
+ ** - 20) Probar que un mensaje que se repite deja la pantalla en blanco entre pasadas, no avisa el final y al
+ **       detenerlo se vuelve a mostrar lo escrito
+ ** - 21) Probar que no se puede comenzar un mensaje con argumentos inválidos
+ **/
+
+/* === Headers files inclusions ==================================================================================== */
+
+#include "unity.h"
+#include "screen.h"
+#include <string.h>
+
+/* === Macros definitions ========================================================================================== */
+
+#define DIGITS 4 //!< Cantidad de dígitos de la pantalla que se somete a prueba
+
+/* === Private data type declarations ============================================================================== */
+
+//! Modelo de la versión anterior del refresco, que calculaba las fases de los parpadeos en cada cuadro
+typedef struct model_s {
+    uint8_t memory_video[DIGITS];         //!< Segmentos escritos en cada display
+    uint8_t flashing_from;                //!< Primer dígito que parpadea
+    uint8_t flashing_to;                  //!< Último dígito que parpadea
+    uint16_t flashing_count;              //!< Cuenta del parpadeo de los dígitos
+    uint16_t flashing_period;             //!< Período del parpadeo de los dígitos
+    uint16_t flashing_dot_count[DIGITS];  //!< Cuenta del parpadeo de cada punto
+    uint16_t flashing_dot_period[DIGITS]; //!< Período del parpadeo de cada punto
+} model_t;
+
+/* === Private function declarations =============================================================================== */
+
+/**
+ * @brief Función de SetUp que crea la pantalla y la deja a punto de comenzar un cuadro
+ *
+ */
+void setUp(void);
+
+/**
+ * @brief Función simulada del driver que apaga todos los displays
+ *
+ */
+static void FakeDigitsTurnOff(void);
+
+/**
+ * @brief Función simulada del driver que registra los segmentos enviados
+ *
+ * @param segments Segmentos que se envían al display
+ */
+static void FakeSegmentsUpdate(uint8_t segments);
+
+/**
+ * @brief Función simulada del driver que registra lo que muestra el display que se enciende
+ *
+ * @param digit Display que se enciende
+ */
+static void FakeDigitTurnOn(uint8_t digit);
+
+/**
+ * @brief Función simulada del driver que registra la fracción de encendido del display encendido
+ *
+ * @param fraction Fracción del intervalo del dígito en que el display permanece encendido
+ */
+static void FakeDigitDim(uint16_t fraction);
+
+/**
+ * @brief Función simulada que recibe el aviso del final de un mensaje que se desplaza
+ *
+ * @param context Contexto indicado al configurar el aviso
+ */
+static void FakeMarqueeDone(void* context);
+
+/**
+ * @brief Función auxiliar que refresca la pantalla durante un cuadro completo (una vez cada dígito)
+ *
+ */
+static void RefreshFrame(void);
+
+/**
+ * @brief Función auxiliar que simula un temporizador periódico que llama a la función de su interrupción
+ *
+ * @param handler Función que se llama en cada interrupción del temporizador
+ * @param context Contexto que recibe la función
+ * @param interrupts Cantidad de interrupciones que se simulan
+ */
+static void FakeTimerRun(void (*handler)(void*), void* context, uint32_t interrupts);
+
+/**
+ * @brief Función auxiliar que calcula un cuadro del modelo, tal como lo hacía la versión anterior del refresco
+ *
+ * @param frame Arreglo donde se guardan los segmentos que se muestran en cada display
+ */
+static void ModelFrame(uint8_t frame[]);
+
+/* === Private variable definitions ================================================================================ */
+
+//! Driver simulado de la pantalla
+static const struct screen_driver_s FAKE_DRIVER = {
+    .DigitsTurnOff = FakeDigitsTurnOff,
+    .SegmentsUpdate = FakeSegmentsUpdate,
+    .DigitTurnOn = FakeDigitTurnOn,
+    .DigitDim = FakeDigitDim,
+};
+
+//! Driver simulado de una pantalla que no se puede atenuar
+static const struct screen_driver_s FAKE_DRIVER_NO_DIM = {
+    .DigitsTurnOff = FakeDigitsTurnOff,
+    .SegmentsUpdate = FakeSegmentsUpdate,
+    .DigitTurnOn = FakeDigitTurnOn,
+};
+
+//! Pantalla que se somete a prueba
+static screen_t screen;
+
+//! Modelo del refresco anterior, para la prueba de equivalencia
+static model_t model;
+
+//! Segmentos enviados al driver que todavía no se mostraron en un display
+static uint8_t pending_segments;
+
+//! Indica si los displays están apagados desde el último envío de segmentos
+static bool digits_off;
+
+//! Segmentos que mostró cada display en el último cuadro
+static uint8_t shown[DIGITS];
+
+//! Último display encendido
+static uint8_t last_digit;
+
+//! Fracción de encendido que tuvo cada display en el último cuadro
+static uint16_t duty[DIGITS];
+
+//! Cantidad de avisos de final de mensaje recibidos
+static int marquee_done_calls;
+
+/* === Public variable definitions ================================================================================= */
+
+/* === Private function definitions ================================================================================ */
+
+void setUp(void) {
+    static screen_storage_t storage;
+
+    screen = ScreenCreateStatic(&storage, DIGITS, &FAKE_DRIVER);
+    memset(&model, 0, sizeof(model));
+    memset(shown, 0, sizeof(shown));
+    marquee_done_calls = 0;
+
+    // La pantalla comienza mostrando el dígito 0, por lo que el próximo cuadro empieza luego de los demás dígitos
+    for (int i = 0; i < DIGITS - 1; i++) {
+        ScreenRefresh(screen);
+    }
+}
+
+static void FakeDigitsTurnOff(void) {
+    digits_off = true;
+}
+
+static void FakeSegmentsUpdate(uint8_t segments) {
+    TEST_ASSERT_TRUE(digits_off);
+    pending_segments = segments;
+}
+
+static void FakeDigitTurnOn(uint8_t digit) {
+    TEST_ASSERT_TRUE(digits_off);
+    TEST_ASSERT_TRUE(digit < DIGITS);
+    digits_off = false;
+    last_digit = digit;
+    shown[digit] = pending_segments;
+    duty[digit] = SCREEN_DUTY_FULL;
+}
+
+static void FakeDigitDim(uint16_t fraction) {
+    TEST_ASSERT_FALSE(digits_off);
+    duty[last_digit] = fraction;
+}
+
+static void FakeMarqueeDone(void* context) {
+    TEST_ASSERT_EQUAL_PTR(&marquee_done_calls, context);
+    marquee_done_calls++;
+}
+
+static void RefreshFrame(void) {
+    for (int i = 0; i < DIGITS; i++) {
+        ScreenRefresh(screen);
+    }
+}
+
+static void FakeTimerRun(void (*handler)(void*), void* context, uint32_t interrupts) {
+    for (uint32_t i = 0; i < interrupts; i++) {
+        handler(context);
+    }
+}
+
+static void ModelFrame(uint8_t frame[]) {
+    if (model.flashing_period != 0) {
+        model.flashing_count = (model.flashing_count + 1) % model.flashing_period;
+    }
+    for (int i = 0; i < DIGITS; i++) {
+        if (model.flashing_dot_period[i] != 0) {
+            model.flashing_dot_count[i] = (model.flashing_dot_count[i] + 1) % model.flashing_dot_period[i];
+        }
+    }
+
+    for (int d = 0; d < DIGITS; d++) {
+        frame[d] = model.memory_video[d];
+        if ((model.flashing_period != 0) && (model.flashing_count < model.flashing_period / 2) && (d >= model.flashing_from) &&
+            (d <= model.flashing_to)) {
+            frame[d] = frame[d] & SEGMENT_P;
+        }
+        if ((model.flashing_dot_period[d] != 0) && (model.flashing_dot_count[d] < model.flashing_dot_period[d] / 2)) {
+            frame[d] = frame[d] & ~SEGMENT_P;
+        }
+    }
+}
+
+/* === Public function definitions ================================================================================= */
+
+// 1) Probar que cada llamada al refresco apaga los displays, envía los segmentos y enciende el siguiente dígito
+void test_refresh_scans_digits_in_order(void) {
+    for (int i = 0; i < 2 * DIGITS; i++) {
+        ScreenRefresh(screen);
+        TEST_ASSERT_FALSE(digits_off);
+        TEST_ASSERT_EQUAL_UINT8(i % DIGITS, last_digit);
+    }
+}
+
+// 2) Probar que un número escrito se muestra a partir del cuadro siguiente y conserva los puntos encendidos
+void test_written_number_shown_from_next_frame(void) {
+    uint8_t value[DIGITS] = {1, 2, 3, 4};
+    uint8_t expected[DIGITS] = {
+        SEGMENT_B | SEGMENT_C,
+        SEGMENT_A | SEGMENT_B | SEGMENT_D | SEGMENT_E | SEGMENT_G | SEGMENT_P,
+        SEGMENT_A | SEGMENT_B | SEGMENT_C | SEGMENT_D | SEGMENT_G,
+        SEGMENT_B | SEGMENT_C | SEGMENT_F | SEGMENT_G,
+    };
+
+    ScreenRefresh(screen);
+    ScreenWriteBCD(screen, value, DIGITS);
+    ScreenSetDotState(screen, 2, true);
+    ScreenRefresh(screen);
+    TEST_ASSERT_EQUAL_HEX8(0, shown[1]);
+
+    // Se termina el cuadro que estaba en curso y se muestra el siguiente
+    for (int i = 2; i < DIGITS; i++) {
+        ScreenRefresh(screen);
+    }
+    RefreshFrame();
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, shown, DIGITS);
+}
+
+// 3) Probar que el parpadeo de los dígitos apaga sus segmentos durante medio período sin apagar los puntos
+void test_flash_digits_blanks_half_period_keeping_dots(void) {
+    uint8_t value[DIGITS] = {8, 8, 8, 8};
+    uint8_t blanked = 0;
+
+    ScreenWriteBCD(screen, value, DIGITS);
+    ScreenSetDotState(screen, 1, true);
+    TEST_ASSERT_EQUAL(0, ScreenFlashDigits(screen, 1, 2, 5));
+
+    for (int i = 0; i < 99; i++) {
+        RefreshFrame();
+        TEST_ASSERT_EQUAL_HEX8(0x7F, shown[0]);
+        TEST_ASSERT_EQUAL_HEX8(0x7F, shown[3]);
+        TEST_ASSERT_EQUAL_HEX8(shown[1] | SEGMENT_P, shown[2]);
+        if (shown[1] == 0) {
+            TEST_ASSERT_EQUAL_HEX8(SEGMENT_P, shown[2]);
+            blanked++;
+        }
+    }
+    // El primer período tiene un cuadro menos apagado, porque la cuenta comienza en uno
+    TEST_ASSERT_EQUAL(10 * 5 - 1, blanked);
+}
+
+// 4) Probar que el parpadeo de un punto lo apaga durante medio período sin afectar al resto del display
+void test_flash_dot_blanks_half_period(void) {
+    uint8_t value[DIGITS] = {0, 0, 0, 0};
+    uint8_t blanked = 0;
+
+    ScreenWriteBCD(screen, value, DIGITS);
+    ScreenSetDotState(screen, 0, true);
+    TEST_ASSERT_EQUAL(0, ScreenFlashDot(screen, 0, 10));
+
+    for (int i = 0; i < 199; i++) {
+        RefreshFrame();
+        TEST_ASSERT_EQUAL_HEX8(0x3F, shown[3] & ~SEGMENT_P);
+        TEST_ASSERT_EQUAL_HEX8(0x3F, shown[0]);
+        if ((shown[3] & SEGMENT_P) == 0) {
+            blanked++;
+        }
+    }
+    TEST_ASSERT_EQUAL(10 * 10 - 1, blanked);
+}
+
+// 5) Probar que volver a configurar el mismo parpadeo no reinicia su fase
+void test_same_flash_config_keeps_phase(void) {
+    uint8_t value[DIGITS] = {8, 8, 8, 8};
+
+    ScreenWriteBCD(screen, value, DIGITS);
+    ScreenFlashDigits(screen, 0, 3, 10);
+
+    for (int i = 0; i < 15; i++) {
+        RefreshFrame();
+        ScreenFlashDigits(screen, 0, 3, 10);
+    }
+    TEST_ASSERT_EQUAL_HEX8(0x7F, shown[0]);
+
+    for (int i = 0; i < 5; i++) {
+        RefreshFrame();
+        ScreenFlashDigits(screen, 0, 3, 10);
+    }
+    TEST_ASSERT_EQUAL_HEX8(0, shown[0]);
+}
+
+// 6) Probar que con varios parpadeos y cambios de configuración se muestra lo mismo que al calcular cada cuadro por
+// separado, como hacía la versión anterior del refresco
+void test_matches_per_frame_computation(void) {
+    uint8_t value[DIGITS] = {1, 9, 5, 7};
+    uint8_t segments[DIGITS] = {SEGMENT_B | SEGMENT_C, 0x6F, 0x6D, 0x07};
+    uint8_t expected[DIGITS];
+
+    for (int frame = 0; frame < 3000; frame++) {
+        if (frame == 10) {
+            ScreenWriteBCD(screen, value, DIGITS);
+            memcpy(model.memory_video, segments, DIGITS);
+        }
+        if ((frame == 20) || (frame == 1500)) {
+            ScreenFlashDigits(screen, 0, 1, (frame == 20) ? 125 : 40);
+            model.flashing_from = 0;
+            model.flashing_to = 1;
+            model.flashing_period = (frame == 20) ? 250 : 80;
+            model.flashing_count = 0;
+        }
+        if (frame == 333) {
+            ScreenSetDotState(screen, 2, true);
+            ScreenFlashDot(screen, 2, 250);
+            model.memory_video[1] |= SEGMENT_P;
+            model.flashing_dot_period[1] = 500;
+        }
+        if (frame == 777) {
+            ScreenSetDotState(screen, 0, true);
+            ScreenFlashDot(screen, 0, 7);
+            model.memory_video[3] |= SEGMENT_P;
+            model.flashing_dot_period[3] = 14;
+        }
+        if (frame == 2222) {
+            ScreenFlashDot(screen, 0, 0);
+            ScreenFlashDigits(screen, 0, 1, 0);
+            model.flashing_dot_period[3] = 0;
+            model.flashing_period = 0;
+        }
+
+        RefreshFrame();
+        ModelFrame(expected);
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, shown, DIGITS);
+    }
+}
+
+// 7) Probar que repetir una escritura o una configuración idéntica no cambia la generación y se cuenta como descartada
+void test_identical_updates_are_elided(void) {
+    uint8_t value[DIGITS] = {1, 2, 3, 4};
+    screen_stats_t stats;
+    uint32_t generation;
+
+    ScreenWriteBCD(screen, value, DIGITS);
+    ScreenFlashDigits(screen, 0, 1, 50);
+    ScreenSetDotState(screen, 1, false);
+    ScreenFlashDot(screen, 1, 0);
+    generation = ScreenGetGeneration(screen);
+
+    for (int i = 0; i < 10; i++) {
+        ScreenWriteBCD(screen, value, DIGITS);
+        ScreenFlashDigits(screen, 0, 1, 50);
+        ScreenSetDotState(screen, 1, false);
+        ScreenFlashDot(screen, 1, 0);
+    }
+
+    ScreenGetStats(screen, &stats);
+    TEST_ASSERT_EQUAL_UINT32(generation, ScreenGetGeneration(screen));
+    TEST_ASSERT_EQUAL_UINT32(generation, stats.accepted);
+    TEST_ASSERT_EQUAL_UINT32(2 + 4 * 10, stats.elided);
+}
+
+// 8) Probar que cada actualización que modifica algo aumenta la generación y se cuenta como aceptada
+void test_changing_updates_are_accepted(void) {
+    uint8_t value[DIGITS] = {1, 2, 3, 4};
+    screen_stats_t stats;
+
+    TEST_ASSERT_EQUAL_UINT32(0, ScreenGetGeneration(screen));
+
+    ScreenWriteBCD(screen, value, DIGITS);
+    TEST_ASSERT_EQUAL_UINT32(1, ScreenGetGeneration(screen));
+    value[3] = 5;
+    ScreenWriteBCD(screen, value, DIGITS);
+    TEST_ASSERT_EQUAL_UINT32(2, ScreenGetGeneration(screen));
+    ScreenFlashDigits(screen, 2, 3, 50);
+    TEST_ASSERT_EQUAL_UINT32(3, ScreenGetGeneration(screen));
+    ScreenSetDotState(screen, 0, true);
+    TEST_ASSERT_EQUAL_UINT32(4, ScreenGetGeneration(screen));
+    ScreenFlashDot(screen, 0, 50);
+    TEST_ASSERT_EQUAL_UINT32(5, ScreenGetGeneration(screen));
+
+    ScreenGetStats(screen, &stats);
+    TEST_ASSERT_EQUAL_UINT32(5, stats.accepted);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.elided);
+}
+
+// 9) Probar que escribir un número apaga los puntos de los dígitos escritos, aunque los segmentos no cambien
+void test_write_clears_dots_of_written_digits(void) {
+    uint8_t value[DIGITS] = {1, 2, 3, 4};
+    uint32_t generation;
+
+    ScreenWriteBCD(screen, value, 2);
+    ScreenSetDotState(screen, 3, true);
+    ScreenSetDotState(screen, 0, true);
+    generation = ScreenGetGeneration(screen);
+
+    ScreenWriteBCD(screen, value, 2);
+    TEST_ASSERT_EQUAL_UINT32(generation + 1, ScreenGetGeneration(screen));
+
+    RefreshFrame();
+    TEST_ASSERT_EQUAL_HEX8(SEGMENT_B | SEGMENT_C, shown[0]);
+    TEST_ASSERT_EQUAL_HEX8(SEGMENT_P, shown[3]);
+}
+
+// 10) Probar que un temporizador simulado que llama a la función de su interrupción barre toda la pantalla, un dígito
+// por interrupción, y que la función ignora una pantalla inexistente
+void test_timer_interrupt_scans_screen(void) {
+    uint8_t value[DIGITS] = {8, 8, 8, 8};
+    uint8_t expected[DIGITS] = {0x7F, 0x7F, 0x7F, 0x7F};
+
+    ScreenWriteBCD(screen, value, DIGITS);
+
+    FakeTimerRun(ScreenRefreshFromISR, screen, 1);
+    TEST_ASSERT_EQUAL_UINT8(0, last_digit);
+
+    FakeTimerRun(ScreenRefreshFromISR, screen, SCREEN_REFRESH_FREQUENCY - 1);
+    TEST_ASSERT_EQUAL_UINT8((SCREEN_REFRESH_FREQUENCY - 1) % DIGITS, last_digit);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, shown, DIGITS);
+
+    FakeTimerRun(ScreenRefreshFromISR, NULL, 10);
+    TEST_ASSERT_EQUAL_UINT8((SCREEN_REFRESH_FREQUENCY - 1) % DIGITS, last_digit);
+}
+
+// 11) Probar que con el brillo máximo ningún display se atenúa
+void test_max_brightness_does_not_dim(void) {
+    uint16_t expected[DIGITS] = {SCREEN_DUTY_FULL, SCREEN_DUTY_FULL, SCREEN_DUTY_FULL, SCREEN_DUTY_FULL};
+
+    TEST_ASSERT_EQUAL(0, ScreenSetBrightness(screen, SCREEN_BRIGHTNESS_MAX));
+    RefreshFrame();
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(expected, duty, DIGITS);
+}
+
+// 12) Probar que los niveles de brillo encienden cada display una fracción creciente de su intervalo, casi nula en el
+// nivel más bajo, y que el nivel 0 apaga los segmentos
+void test_brightness_levels_increase_duty(void) {
+    uint8_t value[DIGITS] = {8, 8, 8, 8};
+    uint16_t previous = 0;
+
+    ScreenWriteBCD(screen, value, DIGITS);
+
+    for (uint8_t level = 1; level < SCREEN_BRIGHTNESS_MAX; level++) {
+        TEST_ASSERT_EQUAL(0, ScreenSetBrightness(screen, level));
+        RefreshFrame();
+        TEST_ASSERT_EQUAL_HEX8(0x7F, shown[0]);
+        TEST_ASSERT_TRUE(duty[0] > previous);
+        TEST_ASSERT_EQUAL_HEX16(duty[0], duty[3]);
+        previous = duty[0];
+    }
+
+    ScreenSetBrightness(screen, 1);
+    RefreshFrame();
+    TEST_ASSERT_TRUE(duty[0] < SCREEN_DUTY_FULL / 100);
+
+    ScreenSetBrightness(screen, 0);
+    RefreshFrame();
+    TEST_ASSERT_EQUAL_HEX8(0, shown[0]);
+    TEST_ASSERT_EQUAL_HEX16(0, duty[0]);
+}
+
+// 13) Probar que el brillo de un dígito no afecta a los demás y que se rechazan dígitos y niveles inválidos
+void test_digit_brightness_is_independent(void) {
+    uint32_t generation;
+
+    TEST_ASSERT_EQUAL(0, ScreenSetDigitBrightness(screen, 0, 8));
+    RefreshFrame();
+    TEST_ASSERT_TRUE(duty[3] < SCREEN_DUTY_FULL);
+    TEST_ASSERT_EQUAL_HEX16(SCREEN_DUTY_FULL, duty[0]);
+    TEST_ASSERT_EQUAL_HEX16(SCREEN_DUTY_FULL, duty[2]);
+
+    generation = ScreenGetGeneration(screen);
+    TEST_ASSERT_EQUAL(-1, ScreenSetDigitBrightness(screen, DIGITS, 8));
+    TEST_ASSERT_EQUAL(-1, ScreenSetDigitBrightness(screen, 0, SCREEN_BRIGHTNESS_MAX + 1));
+    TEST_ASSERT_EQUAL(-1, ScreenSetBrightness(screen, SCREEN_BRIGHTNESS_MAX + 1));
+    TEST_ASSERT_EQUAL(0, ScreenSetDigitBrightness(screen, 0, 8));
+    TEST_ASSERT_EQUAL_UINT32(generation, ScreenGetGeneration(screen));
+}
+
+// 14) Probar que sin la función para atenuar del driver los niveles intermedios se muestran con el brillo máximo
+void test_brightness_without_dim_driver(void) {
+    static screen_storage_t storage;
+    uint8_t value[DIGITS] = {8, 8, 8, 8};
+
+    screen = ScreenCreateStatic(&storage, DIGITS, &FAKE_DRIVER_NO_DIM);
+    ScreenWriteBCD(screen, value, DIGITS);
+    ScreenSetBrightness(screen, 3);
+    ScreenSetDigitBrightness(screen, 3, 0);
+
+    RefreshFrame();
+    RefreshFrame();
+    TEST_ASSERT_EQUAL_HEX8(0, shown[0]);
+    TEST_ASSERT_EQUAL_HEX8(0x7F, shown[1]);
+    TEST_ASSERT_EQUAL_HEX16(SCREEN_DUTY_FULL, duty[1]);
+}
+
+// 15) Probar que ScreenWriteBCD muestra los dígitos hexadecimales y deja en blanco los valores fuera de la tabla
+void test_write_bcd_hex_and_out_of_range(void) {
+    uint8_t value[DIGITS] = {0x0A, 0x0F, 16, 0xFF};
+    uint8_t expected[DIGITS] = {
+        SEGMENT_A | SEGMENT_B | SEGMENT_C | SEGMENT_E | SEGMENT_F | SEGMENT_G,
+        SEGMENT_A | SEGMENT_E | SEGMENT_F | SEGMENT_G,
+        SCREEN_GLYPH_BLANK,
+        SCREEN_GLYPH_BLANK,
+    };
+
+    ScreenWriteBCD(screen, value, DIGITS);
+    RefreshFrame();
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, shown, DIGITS);
+}
+
+// 16) Probar que se pueden escribir palabras como "AL", "SnZ" o "Err" y que los caracteres no representables quedan
+// en blanco
+void test_write_text_words(void) {
+    uint8_t al[DIGITS] = {SEGMENT_A | SEGMENT_B | SEGMENT_C | SEGMENT_E | SEGMENT_F | SEGMENT_G, SEGMENT_D | SEGMENT_E | SEGMENT_F, 0, 0};
+    uint8_t snz[DIGITS] = {
+        SEGMENT_A | SEGMENT_C | SEGMENT_D | SEGMENT_F | SEGMENT_G,
+        SEGMENT_C | SEGMENT_E | SEGMENT_G,
+        SEGMENT_A | SEGMENT_B | SEGMENT_D | SEGMENT_E | SEGMENT_G,
+        0,
+    };
+    uint8_t err[DIGITS] = {SEGMENT_A | SEGMENT_D | SEGMENT_E | SEGMENT_F | SEGMENT_G, SEGMENT_E | SEGMENT_G, SEGMENT_E | SEGMENT_G, SCREEN_GLYPH_MINUS};
+    uint8_t unknown[DIGITS] = {0, 0, 0, 0};
+
+    TEST_ASSERT_EQUAL(0, ScreenWriteText(screen, "AL"));
+    RefreshFrame();
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(al, shown, DIGITS);
+
+    TEST_ASSERT_EQUAL(0, ScreenWriteText(screen, "SnZ"));
+    RefreshFrame();
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(snz, shown, DIGITS);
+
+    TEST_ASSERT_EQUAL(0, ScreenWriteText(screen, "Err-"));
+    RefreshFrame();
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(err, shown, DIGITS);
+
+    TEST_ASSERT_EQUAL(0, ScreenWriteText(screen, "KMW\xFF"));
+    RefreshFrame();
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(unknown, shown, DIGITS);
+
+    TEST_ASSERT_EQUAL(-1, ScreenWriteText(screen, NULL));
+}
+
+// 17) Probar que un punto en el texto se muestra en el dígito anterior y que un texto largo se trunca
+void test_write_text_dots_and_truncation(void) {
+    uint8_t glyphs[8];
+
+    TEST_ASSERT_EQUAL(0, ScreenWriteText(screen, "12.34"));
+    RefreshFrame();
+    TEST_ASSERT_EQUAL_HEX8(SEGMENT_A | SEGMENT_B | SEGMENT_D | SEGMENT_E | SEGMENT_G | SEGMENT_P, shown[1]);
+    TEST_ASSERT_EQUAL_HEX8(SEGMENT_B | SEGMENT_C | SEGMENT_F | SEGMENT_G, shown[3]);
+
+    TEST_ASSERT_EQUAL(3, ScreenTextToGlyphs(".1..", glyphs, sizeof(glyphs)));
+    TEST_ASSERT_EQUAL_HEX8(SEGMENT_P, glyphs[0]);
+    TEST_ASSERT_EQUAL_HEX8(SEGMENT_B | SEGMENT_C | SEGMENT_P, glyphs[1]);
+    TEST_ASSERT_EQUAL_HEX8(SEGMENT_P, glyphs[2]);
+
+    TEST_ASSERT_EQUAL(8, ScreenTextToGlyphs("HELLO.123", NULL, 0));
+    TEST_ASSERT_EQUAL(-1, ScreenWriteText(screen, "HELLO"));
+    RefreshFrame();
+    TEST_ASSERT_EQUAL_HEX8(SEGMENT_D | SEGMENT_E | SEGMENT_F, shown[3]);
+}
+
+// 18) Probar que se pueden escribir los segmentos de varios dígitos en una sola llamada
+void test_write_glyphs(void) {
+    uint8_t glyphs[DIGITS + 1] = {SEGMENT_A, SEGMENT_B | SEGMENT_P, SEGMENT_C, SEGMENT_D, SEGMENT_E};
+    uint8_t expected[DIGITS] = {SEGMENT_A, SEGMENT_B | SEGMENT_P, 0, 0};
+    uint32_t generation;
+
+    ScreenWriteGlyphs(screen, glyphs, 2);
+    RefreshFrame();
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, shown, DIGITS);
+
+    generation = ScreenGetGeneration(screen);
+    ScreenWriteGlyphs(screen, glyphs, 2);
+    TEST_ASSERT_EQUAL_UINT32(generation, ScreenGetGeneration(screen));
+
+    ScreenWriteGlyphs(screen, glyphs, DIGITS + 1);
+    RefreshFrame();
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(glyphs, shown, DIGITS);
+}
+
+// 19) Probar que un mensaje de una sola pasada entra por la derecha, sale por la izquierda al ritmo indicado, avisa que
+// terminó y la pantalla vuelve a mostrar lo escrito
+void test_marquee_once(void) {
+    uint8_t value[DIGITS] = {1, 2, 3, 4};
+    uint8_t message[] = {SEGMENT_A, SEGMENT_B, SEGMENT_C, SEGMENT_D, SEGMENT_E, SEGMENT_F};
+    uint8_t expected[DIGITS];
+    uint8_t written[DIGITS];
+
+    ScreenWriteBCD(screen, value, DIGITS);
+    RefreshFrame();
+    memcpy(written, shown, DIGITS);
+
+    ScreenSetMarqueeSink(screen, FakeMarqueeDone, &marquee_done_calls);
+    TEST_ASSERT_EQUAL(0, ScreenMarqueeStart(screen, message, sizeof(message), 3, SCREEN_MARQUEE_ONCE));
+    TEST_ASSERT_TRUE(ScreenMarqueeIsRunning(screen));
+
+    // La pasada recorre las posiciones 1 a 9: el mensaje de 6 dígitos más los 4 dígitos de la pantalla
+    for (int position = 1; position < (int)sizeof(message) + DIGITS; position++) {
+        for (int frame = 0; frame < 3; frame++) {
+            RefreshFrame();
+            for (int i = 0; i < DIGITS; i++) {
+                int glyph = position + i - DIGITS;
+                expected[i] = ((glyph >= 0) && (glyph < (int)sizeof(message))) ? message[glyph] : 0;
+            }
+            TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, shown, DIGITS);
+        }
+        TEST_ASSERT_EQUAL(0, marquee_done_calls);
+    }
+
+    RefreshFrame();
+    TEST_ASSERT_EQUAL(1, marquee_done_calls);
+    TEST_ASSERT_FALSE(ScreenMarqueeIsRunning(screen));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(written, shown, DIGITS);
+
+    for (int frame = 0; frame < 100; frame++) {
+        RefreshFrame();
+    }
+    TEST_ASSERT_EQUAL(1, marquee_done_calls);
+}
+
+// 20) Probar que un mensaje que se repite deja la pantalla en blanco entre pasadas, no avisa el final y al detenerlo se
+// vuelve a mostrar lo escrito
+void test_marquee_loop_and_stop(void) {
+    uint8_t value[DIGITS] = {1, 2, 3, 4};
+    uint8_t message[] = {SEGMENT_A, SEGMENT_B};
+    uint8_t blank[DIGITS] = {0, 0, 0, 0};
+    uint8_t first[DIGITS] = {0, 0, 0, SEGMENT_A};
+    uint8_t written[DIGITS];
+
+    ScreenWriteBCD(screen, value, DIGITS);
+    RefreshFrame();
+    memcpy(written, shown, DIGITS);
+
+    ScreenSetMarqueeSink(screen, FakeMarqueeDone, &marquee_done_calls);
+    ScreenMarqueeStart(screen, message, sizeof(message), 1, SCREEN_MARQUEE_LOOP);
+
+    for (int pass = 0; pass < 3; pass++) {
+        // Cada pasada ocupa las 6 posiciones del mensaje y la pantalla, y la siguiente comienza en blanco
+        RefreshFrame();
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(first, shown, DIGITS);
+        for (int frame = 1; frame < (int)sizeof(message) + DIGITS - 1; frame++) {
+            RefreshFrame();
+        }
+        TEST_ASSERT_EQUAL_HEX8(SEGMENT_B, shown[0]);
+        RefreshFrame();
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(blank, shown, DIGITS);
+    }
+    TEST_ASSERT_TRUE(ScreenMarqueeIsRunning(screen));
+
+    ScreenMarqueeStop(screen);
+    RefreshFrame();
+    TEST_ASSERT_FALSE(ScreenMarqueeIsRunning(screen));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(written, shown, DIGITS);
+    TEST_ASSERT_EQUAL(0, marquee_done_calls);
+}
+
+// 21) Probar que no se puede comenzar un mensaje con argumentos inválidos
+void test_marquee_invalid_arguments(void) {
+    uint8_t message[] = {SEGMENT_A};
+
+    TEST_ASSERT_EQUAL(-1, ScreenMarqueeStart(NULL, message, 1, 1, SCREEN_MARQUEE_ONCE));
+    TEST_ASSERT_EQUAL(-1, ScreenMarqueeStart(screen, NULL, 1, 1, SCREEN_MARQUEE_ONCE));
+    TEST_ASSERT_EQUAL(-1, ScreenMarqueeStart(screen, message, 0, 1, SCREEN_MARQUEE_ONCE));
+    TEST_ASSERT_EQUAL(-1, ScreenMarqueeStart(screen, message, 1, 0, SCREEN_MARQUEE_ONCE));
+    TEST_ASSERT_FALSE(ScreenMarqueeIsRunning(screen));
+}
+
+/* === End of documentation ======================================================================================== */